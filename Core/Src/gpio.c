@@ -25,6 +25,7 @@
 #include "elog.h"
 
 extern void uwb_int_handler_wrapper(void);
+extern void uwb_rdy_handler_wrapper(void);
 /* USER CODE END 0 */
 
 /*----------------------------------------------------------------------------*/
@@ -92,7 +93,7 @@ void MX_GPIO_Init(void)
 
   /*Configure GPIO pin : UWB_RDY_Pin */
   GPIO_InitStruct.Pin = UWB_RDY_Pin;
-  GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
   GPIO_InitStruct.Pull = GPIO_NOPULL;
   HAL_GPIO_Init(UWB_RDY_GPIO_Port, &GPIO_InitStruct);
 
@@ -111,6 +112,10 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
     // elog_i("EXTI", "INT low");
     uwb_int_handler_wrapper();
   }
+  else if (GPIO_Pin == UWB_RDY_Pin)
+  {
+    uwb_rdy_handler_wrapper();
+  }
 }
 
 /* USER CODE END 2 */
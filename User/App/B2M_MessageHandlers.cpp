@@ -409,6 +409,15 @@ std::unique_ptr<Message> SetUwbChannelHandler::processMessage(const Message &mes
     auto response = std::make_unique<Master2Backend::SetUwbChannelResponseMessage>();
     response->channel = channelMsg->channel;
 
+    // 已在目标信道时直接应答，不打扰UWB任务
+    uwb_radio_state_t radio;
+    if (UWB_GetRadioState(&radio) == 0 && radio.channel == channelMsg->channel)
+    {
+        response->status = 0;
+        elog_i("SetUwbChannelHandler", "UWB already on channel %d", static_cast<int>(radio.channel));
+        return std::move(response);
+    }
+
     // 尝试设置UWB信道
     int result = UWB_SetChannel(channelMsg->channel);
 
@@ -435,4 +444,159 @@ void SetUwbChannelHandler::executeActions(const Message &message, MasterServer *
 
     elog_d("SetUwbChannelHandler", "UWB channel setting action completed for channel %d",
            static_cast<int>(channelMsg->channel));
+}
+
+// Link Stats Request Handler
+std::unique_ptr<Message> LinkStatsHandler::processMessage(const Message &message, MasterServer *server)
+{
+    const auto *statsMsg = dynamic_cast<const Backend2Master::LinkStatsReqMessage *>(&message);
+    if (!statsMsg)
+        return nullptr;
+
+    elog_v("LinkStatsHandler", "Processing link stats request for target 0x%08X", statsMsg->targetId);
+
+    auto response = std::make_unique<Master2Backend::LinkStatsResponseMessage>();
+    response->masterTimeMs = getCurrentTimestampMs();
+
+    for (const auto &entry : server->getDeviceManager().getAllLinkStats())
+    {
+        if (statsMsg->targetId != BROADCAST_SLAVE_ID && statsMsg->targetId != entry.first)
+            continue;
+
+        const SlaveLinkStats &stats = entry.second;
+        Master2Backend::LinkStatsResponseMessage::SlaveLinkInfo info;
+        info.slaveId = entry.first;
+        info.rxFrames = stats.rxFrames;
+        info.seqGaps = stats.seqGaps;
+        info.retries = stats.retries;
+        info.retryRecovered = stats.retryRecovered;
+        info.retryExhausted = stats.retryExhausted;
+        info.lastRxTimeMs = stats.lastRxTimeMs;
+        info.rssi = stats.rssi;
+        info.quality = stats.quality;
+        response->slaves.push_back(info);
+    }
+    response->slaveNum = static_cast<uint8_t>(response->slaves.size());
+
+    elog_i("LinkStatsHandler", "Link stats response contains %d slaves", static_cast<int>(response->slaveNum));
+
+    return std::move(response);
+}
+
+void LinkStatsHandler::executeActions(const Message &message, MasterServer *server)
+{
+    const auto *statsMsg = dynamic_cast<const Backend2Master::LinkStatsReqMessage *>(&message);
+    if (!statsMsg)
+        return;
+
+    // 响应已在processMessage中生成，此处按请求清零统计
+    if (statsMsg->clear)
+    {
+        server->getDeviceManager().clearLinkStats(statsMsg->targetId);
+        elog_i("LinkStatsHandler", "Link stats cleared for target 0x%08X", statsMsg->targetId);
+    }
+}
+
+// PHY Profile Config Handler
+std::unique_ptr<Message> PhyProfileHandler::processMessage(const Message &message, MasterServer *server)
+{
+    const auto *profileMsg = dynamic_cast<const Backend2Master::PhyProfileConfigMessage *>(&message);
+    if (!profileMsg)
+        return nullptr;
+
+    elog_i("PhyProfileHandler", "Processing PHY profile request - Profile: %d, Adaptive: %d",
+           static_cast<int>(profileMsg->profile), static_cast<int>(profileMsg->adaptive));
+
+    auto response = std::make_unique<Master2Backend::PhyProfileConfigResponseMessage>();
+    response->profile = profileMsg->profile;
+    response->adaptive = server->phyAdaptive ? 1 : 0;
+
+    if (profileMsg->profile >= UWB_PHY_PROFILE_NUM)
+    {
+        response->status = 1;
+        elog_e("PhyProfileHandler", "Invalid PHY profile %d", static_cast<int>(profileMsg->profile));
+        return std::move(response);
+    }
+
+    // 已在目标档位时不打扰UWB任务
+    uwb_radio_state_t radio;
+    int result = 0;
+    if (UWB_GetRadioState(&radio) != 0 || radio.profile != profileMsg->profile)
+    {
+        result = UWB_SetPhyProfile(static_cast<uwb_phy_profile_t>(profileMsg->profile));
+    }
+
+    if (result == 0)
+    {
+        response->status = 0;
+        response->adaptive = profileMsg->adaptive ? 1 : 0;
+        elog_i("PhyProfileHandler", "PHY profile %d selected", static_cast<int>(profileMsg->profile));
+    }
+    else
+    {
+        response->status = 1;
+        elog_e("PhyProfileHandler", "Failed to select PHY profile %d, error: %d",
+               static_cast<int>(profileMsg->profile), result);
+    }
+
+    return std::move(response);
+}
+
+void PhyProfileHandler::executeActions(const Message &message, MasterServer *server)
+{
+    const auto *profileMsg = dynamic_cast<const Backend2Master::PhyProfileConfigMessage *>(&message);
+    if (!profileMsg || profileMsg->profile >= UWB_PHY_PROFILE_NUM)
+        return;
+
+    // 以选定档位为起点开启或关闭自适应切换
+    server->setPhyAdaptive(profileMsg->adaptive != 0);
+    elog_i("PhyProfileHandler", "PHY profile adaptation %s", profileMsg->adaptive ? "enabled" : "disabled");
+}
+
+// UWB Benchmark Control Handler
+std::unique_ptr<Message> UwbBenchHandler::processMessage(const Message &message, MasterServer *server)
+{
+    const auto *benchMsg = dynamic_cast<const Backend2Master::UwbBenchCtrlMessage *>(&message);
+    if (!benchMsg)
+        return nullptr;
+
+    elog_i("UwbBenchHandler", "Processing UWB bench request - Target: 0x%08X, Size: %d, Count: %d, Interval: %d",
+           benchMsg->targetId, benchMsg->packetSize, benchMsg->count, benchMsg->interval);
+
+    // count为0表示停止当前测试，停止后的结果由finishUwbBench上报
+    bool accepted;
+    if (benchMsg->count == 0)
+        accepted = server->stopUwbBench();
+    else
+        accepted = server->startUwbBench(benchMsg->targetId, benchMsg->packetSize, benchMsg->count, benchMsg->interval);
+    if (accepted)
+    {
+        // 测试结果在MainTask中测试结束时发送
+        return nullptr;
+    }
+
+    auto response = std::make_unique<Master2Backend::UwbBenchResultMessage>();
+    response->status = UWB_BENCH_STATUS_REJECTED;
+    response->targetId = benchMsg->targetId;
+    response->packetSize = benchMsg->packetSize;
+    response->totalCount = benchMsg->count;
+    response->sentCount = 0;
+    response->receivedCount = 0;
+    response->lostCount = 0;
+    response->reorderedCount = 0;
+    response->duplicateCount = 0;
+    response->durationMs = 0;
+    response->txThroughputBps = 0;
+    response->minRttUs = 0;
+    response->p50RttUs = 0;
+    response->p90RttUs = 0;
+    response->p99RttUs = 0;
+    response->maxRttUs = 0;
+    response->rxThroughputBps = 0;
+    return std::move(response);
+}
+
+void UwbBenchHandler::executeActions(const Message &message, MasterServer *server)
+{
+    // 测试已在processMessage中启动或停止，发送由MainTask的processUwbBench按队列空位推进
 }
\ No newline at end of file
@@ -191,4 +191,58 @@ class SetUwbChannelHandler : public IMessageHandler
     SetUwbChannelHandler() = default;
     SetUwbChannelHandler(const SetUwbChannelHandler &) = delete;
     SetUwbChannelHandler &operator=(const SetUwbChannelHandler &) = delete;
+};
+
+// Link Stats Request Handler
+class LinkStatsHandler : public IMessageHandler
+{
+  public:
+    static LinkStatsHandler &getInstance()
+    {
+        static LinkStatsHandler instance;
+        return instance;
+    }
+    std::unique_ptr<Message> processMessage(const Message &message, MasterServer *server) override;
+    void executeActions(const Message &message, MasterServer *server) override;
+
+  private:
+    LinkStatsHandler() = default;
+    LinkStatsHandler(const LinkStatsHandler &) = delete;
+    LinkStatsHandler &operator=(const LinkStatsHandler &) = delete;
+};
+
+// PHY Profile Config Handler
+class PhyProfileHandler : public IMessageHandler
+{
+  public:
+    static PhyProfileHandler &getInstance()
+    {
+        static PhyProfileHandler instance;
+        return instance;
+    }
+    std::unique_ptr<Message> processMessage(const Message &message, MasterServer *server) override;
+    void executeActions(const Message &message, MasterServer *server) override;
+
+  private:
+    PhyProfileHandler() = default;
+    PhyProfileHandler(const PhyProfileHandler &) = delete;
+    PhyProfileHandler &operator=(const PhyProfileHandler &) = delete;
+};
+
+// UWB Benchmark Control Handler
+class UwbBenchHandler : public IMessageHandler
+{
+  public:
+    static UwbBenchHandler &getInstance()
+    {
+        static UwbBenchHandler instance;
+        return instance;
+    }
+    std::unique_ptr<Message> processMessage(const Message &message, MasterServer *server) override;
+    void executeActions(const Message &message, MasterServer *server) override;
+
+  private:
+    UwbBenchHandler() = default;
+    UwbBenchHandler(const UwbBenchHandler &) = delete;
+    UwbBenchHandler &operator=(const UwbBenchHandler &) = delete;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "LatencyHistogram.h"
 #include "WhtsProtocol.h"
 #include "master_app.h"
 
@@ -24,6 +25,54 @@ struct PendingCommand
     }
 };
 
+// 最近发出的Ping请求的发送时刻，按序列号查找，RTT在主机侧计算，不依赖从机回传的时间戳
+// 固定容量环形记录：序列号超出最近N个时视为过期响应
+template <uint16_t N> class PingSendHistory
+{
+  public:
+    PingSendHistory() : entries_()
+    {
+    }
+
+    void record(uint16_t seq, uint64_t sendUs)
+    {
+        Entry &entry = entries_[seq % N];
+        entry.seq = seq;
+        entry.valid = true;
+        entry.sendUs = sendUs;
+    }
+
+    bool find(uint16_t seq, uint64_t &sendUs) const
+    {
+        const Entry &entry = entries_[seq % N];
+        if (!entry.valid || entry.seq != seq)
+            return false;
+
+        sendUs = entry.sendUs;
+        return true;
+    }
+
+  private:
+    struct Entry
+    {
+        uint16_t seq;
+        bool valid;
+        uint64_t sendUs;
+    };
+    Entry entries_[N];
+};
+
+// Per-slave RTT statistics collected during a ping session
+struct SlaveRttStats
+{
+    uint16_t successCount;
+    LatencyHistogram rttUs;
+
+    SlaveRttStats() : successCount(0)
+    {
+    }
+};
+
 // Ping session tracking
 struct PingSession
 {
@@ -35,6 +84,14 @@ struct PingSession
     uint16_t interval;
     uint32_t lastPingTime;
     std::unique_ptr<Message> originalMessage; // Store original ping control message for response
+    std::unordered_map<uint32_t, SlaveRttStats> slaveStats; // Slave ID -> RTT statistics
+    PingSendHistory<PING_SEND_HISTORY> sendHistory;         // 序列号 -> 发送时刻
+
+    // 是否接受该从机的响应（广播会话接受所有从机）
+    bool matchesSlave(uint32_t slaveId) const
+    {
+        return targetId == slaveId || targetId == BROADCAST_SLAVE_ID;
+    }
 
     PingSession(uint32_t target, uint8_t mode, uint16_t total, uint16_t intervalMs)
         : targetId(target), pingMode(mode), totalCount(total), currentCount(0), successCount(0), interval(intervalMs),
@@ -49,6 +106,58 @@ struct PingSession
     }
 };
 
+// UWB吞吐测试会话：用带填充的Ping请求压满链路，按从机回传的序号统计丢包，按主机记录的发送时刻统计RTT
+struct UwbBenchSession
+{
+    uint32_t targetId;
+    uint16_t packetSize;    // 每帧空口长度（字节）
+    uint16_t paddingLength; // Ping请求尾部填充字节数
+    uint16_t responseSize;  // Ping响应帧长（字节），从机不填充
+    uint16_t totalCount;
+    uint16_t interval;      // 发送间隔 (ms)，0表示按发送队列空位连续发送
+    uint16_t sentCount;
+    uint16_t receivedCount;
+    uint16_t reorderedCount;
+    uint16_t duplicateCount;
+    int32_t highestIndex;      // 已收到的最大帧序号，-1表示尚未收到
+    uint32_t lastSendTime;     // ms
+    uint32_t lastActivityTime; // 最近一次发送或收到响应 (ms)
+    uint64_t firstSendUs;
+    uint64_t lastRxUs;
+    LatencyHistogram rttUs;
+    PingSendHistory<UWB_BENCH_SEND_HISTORY> sendHistory; // 帧序号 -> 发送时刻
+    std::vector<uint8_t> receivedMap;                    // 每帧1位，用于去重
+
+    UwbBenchSession(uint32_t target, uint16_t size, uint16_t padding, uint16_t total, uint16_t intervalMs)
+        : targetId(target), packetSize(size), paddingLength(padding), responseSize(0), totalCount(total),
+          interval(intervalMs), sentCount(0), receivedCount(0), reorderedCount(0), duplicateCount(0), highestIndex(-1),
+          lastSendTime(0), lastActivityTime(0), firstSendUs(0), lastRxUs(0), receivedMap((total + 7) / 8, 0)
+    {
+    }
+
+    // 记录一帧响应，重复或越界时返回false
+    bool markReceived(uint16_t index)
+    {
+        if (index >= sentCount)
+            return false;
+
+        uint8_t bit = static_cast<uint8_t>(1U << (index & 7));
+        if (receivedMap[index >> 3] & bit)
+        {
+            duplicateCount++;
+            return false;
+        }
+        receivedMap[index >> 3] |= bit;
+        receivedCount++;
+
+        if (static_cast<int32_t>(index) < highestIndex)
+            reorderedCount++;
+        else
+            highestIndex = index;
+        return true;
+    }
+};
+
 // Configuration tracking for backend command responses
 struct PendingBackendResponse
 {
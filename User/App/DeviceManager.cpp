@@ -248,6 +248,7 @@ void DeviceManager::removeDeviceInfo(uint32_t deviceId)
 
         // 同时从连接状态中移除
         connectedSlaves.erase(deviceId);
+        linkStats.erase(deviceId);
 
         elog_i("DeviceManager", "Device 0x%08X completely removed from all lists", deviceId);
     }
@@ -391,6 +392,121 @@ void DeviceManager::cleanupExpiredDevices(uint32_t timeoutMs)
     }
 }
 
+// 链路统计管理方法实现
+void DeviceManager::recordSlaveRx(uint32_t slaveId, const LinkRxInfo *rxInfo)
+{
+    if (slaveId == BROADCAST_SLAVE_ID)
+        return;
+
+    SlaveLinkStats &stats = linkStats[slaveId];
+    stats.rxFrames++;
+    stats.lastRxTimeMs = getCurrentTimestampMs();
+    if (rxInfo)
+    {
+        stats.rssi = rxInfo->rssi;
+        stats.quality = rxInfo->quality;
+    }
+}
+
+void DeviceManager::recordSlavePingSent(uint32_t slaveId)
+{
+    if (slaveId != BROADCAST_SLAVE_ID)
+    {
+        linkStats[slaveId].pingsSent++;
+        return;
+    }
+
+    for (uint32_t id : getConnectedSlaves())
+    {
+        linkStats[id].pingsSent++;
+    }
+}
+
+void DeviceManager::recordSlavePingSequence(uint32_t slaveId, uint16_t sequenceNumber)
+{
+    if (slaveId == BROADCAST_SLAVE_ID || sequenceNumber == 0)
+        return;
+
+    SlaveLinkStats &stats = linkStats[slaveId];
+    // 序列号回退说明开始了新的Ping会话（序列号从1开始）
+    uint16_t expected = (sequenceNumber > stats.lastPingSeq) ? stats.lastPingSeq + 1 : 1;
+    if (sequenceNumber > expected)
+    {
+        stats.seqGaps += sequenceNumber - expected;
+        elog_v("DeviceManager", "Slave 0x%08X ping seq gap: expected %d, got %d", slaveId, expected, sequenceNumber);
+    }
+    stats.lastPingSeq = sequenceNumber;
+    stats.pingResponses++;
+}
+
+void DeviceManager::recordSlaveRetry(uint32_t slaveId)
+{
+    if (slaveId == BROADCAST_SLAVE_ID)
+        return;
+
+    linkStats[slaveId].retries++;
+}
+
+void DeviceManager::recordSlaveRetryOutcome(uint32_t slaveId, bool recovered)
+{
+    if (slaveId == BROADCAST_SLAVE_ID)
+        return;
+
+    SlaveLinkStats &stats = linkStats[slaveId];
+    if (recovered)
+    {
+        stats.retryRecovered++;
+    }
+    else
+    {
+        stats.retryExhausted++;
+    }
+}
+
+bool DeviceManager::getSlaveLinkStats(uint32_t slaveId, SlaveLinkStats &stats) const
+{
+    auto it = linkStats.find(slaveId);
+    if (it == linkStats.end())
+        return false;
+
+    stats = it->second;
+    return true;
+}
+
+std::vector<std::pair<uint32_t, SlaveLinkStats>> DeviceManager::getAllLinkStats() const
+{
+    std::vector<std::pair<uint32_t, SlaveLinkStats>> result;
+    result.reserve(linkStats.size());
+    for (const auto &pair : linkStats)
+    {
+        result.push_back(pair);
+    }
+    return result;
+}
+
+void DeviceManager::clearLinkStats(uint32_t slaveId)
+{
+    if (slaveId == BROADCAST_SLAVE_ID)
+    {
+        linkStats.clear();
+        elog_v("DeviceManager", "Cleared all link statistics");
+        return;
+    }
+
+    // 保留最后接收时间和信号质量，只清零计数
+    auto it = linkStats.find(slaveId);
+    if (it != linkStats.end())
+    {
+        SlaveLinkStats cleared;
+        cleared.lastRxTimeMs = it->second.lastRxTimeMs;
+        cleared.rssi = it->second.rssi;
+        cleared.quality = it->second.quality;
+        cleared.lastPingSeq = it->second.lastPingSeq;
+        it->second = cleared;
+        elog_v("DeviceManager", "Cleared link statistics for slave 0x%08X", slaveId);
+    }
+}
+
 // 从机复位状态管理方法实现
 void DeviceManager::markSlaveForReset(uint32_t slaveId)
 {
@@ -442,5 +558,8 @@ void DeviceManager::clearAllDevices()
     // 清除复位标志
     clearAllResetFlags();
 
+    // 清除链路统计
+    clearLinkStats();
+
     elog_i("DeviceManager", "Cleared all device information (%d devices removed)", static_cast<int>(deviceCount));
 }
\ No newline at end of file
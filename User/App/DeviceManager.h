@@ -68,6 +68,40 @@ struct DataCollectionInfo
     }
 };
 
+// 链路信号质量未知标记
+#define LINK_RSSI_UNKNOWN INT8_MIN
+#define LINK_QUALITY_UNKNOWN 0xFF
+
+// 单帧接收附带的链路信息 (来自UWB驱动)
+struct LinkRxInfo
+{
+    int8_t rssi;       // 接收信号强度 (dBm)，LINK_RSSI_UNKNOWN表示不可用
+    uint8_t quality;   // 首径信噪比 (dB)，LINK_QUALITY_UNKNOWN表示不可用
+    uint64_t rxTimeUs; // 帧接收时刻 (us，与getCurrentTimestampUs同一时基)，0表示不可用
+};
+
+// 每个从机的链路统计
+struct SlaveLinkStats
+{
+    uint32_t rxFrames;       // 接收帧数
+    uint16_t seqGaps;        // Ping序列号缺口（丢失的响应数）
+    uint16_t retries;        // 命令重发次数
+    uint16_t retryRecovered; // 重发后收到响应的命令数
+    uint16_t retryExhausted; // 重发耗尽仍失败的命令数
+    uint32_t lastRxTimeMs;   // 最后一次接收时间 (ms)
+    int8_t rssi;             // 最近一次接收的RSSI
+    uint8_t quality;         // 最近一次接收的链路质量
+    uint16_t lastPingSeq;    // 最近一次Ping响应序列号，0表示无
+    uint32_t pingsSent;      // 发给该从机的Ping请求数（广播请求计入每个在线从机）
+    uint32_t pingResponses;  // 收到的Ping响应数，与pingsSent一起计算丢包率
+
+    SlaveLinkStats()
+        : rxFrames(0), seqGaps(0), retries(0), retryRecovered(0), retryExhausted(0), lastRxTimeMs(0),
+          rssi(LINK_RSSI_UNKNOWN), quality(LINK_QUALITY_UNKNOWN), lastPingSeq(0), pingsSent(0), pingResponses(0)
+    {
+    }
+};
+
 inline uint32_t getCurrentTimestampMs()
 {
     return hal_hptimer_get_ms();
@@ -100,6 +134,9 @@ class DeviceManager
     uint8_t systemRunningStatus;  // 0=Stop, 1=Run, 2=Reset
     uint8_t configuredIntervalMs; // 配置的间隔时间，从Backend2Master消息设置
 
+    // 链路统计
+    std::unordered_map<uint32_t, SlaveLinkStats> linkStats; // slaveId -> SlaveLinkStats
+
     // 数据采集管理 (简化版)
     bool dataCollectionActive;
     CollectionCycleState cycleState; // 当前采集周期状态 (只有IDLE和COLLECTING)
@@ -156,6 +193,16 @@ class DeviceManager
     CollectionCycleState getCycleState() const;
     bool isDataCollectionActive() const;
 
+    // 链路统计管理
+    void recordSlaveRx(uint32_t slaveId, const LinkRxInfo *rxInfo);
+    void recordSlavePingSent(uint32_t slaveId); // 广播ID表示发给所有在线从机
+    void recordSlavePingSequence(uint32_t slaveId, uint16_t sequenceNumber);
+    void recordSlaveRetry(uint32_t slaveId);
+    void recordSlaveRetryOutcome(uint32_t slaveId, bool recovered);
+    bool getSlaveLinkStats(uint32_t slaveId, SlaveLinkStats &stats) const;
+    std::vector<std::pair<uint32_t, SlaveLinkStats>> getAllLinkStats() const;
+    void clearLinkStats(uint32_t slaveId = BROADCAST_SLAVE_ID); // 广播ID表示清除所有从机
+
     // 从机复位状态管理
     void markSlaveForReset(uint32_t slaveId);
     void clearSlaveResetFlag(uint32_t slaveId);
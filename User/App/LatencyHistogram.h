@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// 固定桶延迟直方图（单位：微秒）
+// 0 ~ 1023us 按 64us 线性分桶；1024us ~ 2^20us 每个倍频程再分 8 个子桶（相对误差 <= 12.5%）；
+// 超出范围的样本计入溢出桶。内存固定，不做动态分配，可直接放在会话结构中。
+class LatencyHistogram
+{
+  public:
+    static constexpr uint8_t LINEAR_BUCKETS = 16;
+    static constexpr uint8_t LINEAR_SHIFT = 6; // 64us
+    static constexpr uint8_t LOG_FIRST_MSB = 10;
+    static constexpr uint8_t LOG_LAST_MSB = 19;
+    static constexpr uint8_t SUB_BUCKET_BITS = 3;
+    static constexpr uint8_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr uint8_t BUCKET_COUNT =
+        LINEAR_BUCKETS + (LOG_LAST_MSB - LOG_FIRST_MSB + 1) * SUB_BUCKETS + 1; // +1 溢出桶
+
+    LatencyHistogram()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        memset(buckets_, 0, sizeof(buckets_));
+        count_ = 0;
+        sum_ = 0;
+        min_ = UINT32_MAX;
+        max_ = 0;
+    }
+
+    void record(uint32_t valueUs)
+    {
+        uint8_t index = bucketIndex(valueUs);
+        if (buckets_[index] < UINT16_MAX)
+        {
+            buckets_[index]++;
+        }
+        count_++;
+        sum_ += valueUs;
+        if (valueUs < min_)
+            min_ = valueUs;
+        if (valueUs > max_)
+            max_ = valueUs;
+    }
+
+    uint32_t count() const
+    {
+        return count_;
+    }
+
+    uint32_t min() const
+    {
+        return count_ ? min_ : 0;
+    }
+
+    uint32_t max() const
+    {
+        return max_;
+    }
+
+    uint32_t mean() const
+    {
+        return count_ ? static_cast<uint32_t>(sum_ / count_) : 0;
+    }
+
+    // 返回第 percent 百分位所在桶的上界，并限制在 [min, max] 范围内
+    uint32_t percentile(uint8_t percent) const
+    {
+        if (count_ == 0)
+            return 0;
+
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            total += buckets_[i];
+        }
+
+        uint32_t rank = (total * percent + 99) / 100;
+        if (rank == 0)
+            rank = 1;
+
+        uint32_t seen = 0;
+        for (uint8_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            seen += buckets_[i];
+            if (seen >= rank)
+            {
+                uint32_t value = bucketUpperBound(i);
+                if (value > max_)
+                    value = max_;
+                if (value < min_)
+                    value = min_;
+                return value;
+            }
+        }
+        return max_;
+    }
+
+  private:
+    static uint8_t bucketIndex(uint32_t valueUs)
+    {
+        if (valueUs < (static_cast<uint32_t>(LINEAR_BUCKETS) << LINEAR_SHIFT))
+        {
+            return static_cast<uint8_t>(valueUs >> LINEAR_SHIFT);
+        }
+
+        uint8_t msb = 31 - __builtin_clz(valueUs);
+        if (msb > LOG_LAST_MSB)
+        {
+            return BUCKET_COUNT - 1;
+        }
+
+        uint8_t sub = (valueUs >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return LINEAR_BUCKETS + (msb - LOG_FIRST_MSB) * SUB_BUCKETS + sub;
+    }
+
+    static uint32_t bucketUpperBound(uint8_t index)
+    {
+        if (index < LINEAR_BUCKETS)
+        {
+            return ((static_cast<uint32_t>(index) + 1) << LINEAR_SHIFT) - 1;
+        }
+        if (index >= BUCKET_COUNT - 1)
+        {
+            return UINT32_MAX;
+        }
+
+        uint8_t logIndex = index - LINEAR_BUCKETS;
+        uint8_t msb = LOG_FIRST_MSB + logIndex / SUB_BUCKETS;
+        uint32_t sub = logIndex % SUB_BUCKETS;
+        return ((SUB_BUCKETS + sub + 1) << (msb - SUB_BUCKET_BITS)) - 1;
+    }
+
+    uint16_t buckets_[BUCKET_COUNT];
+    uint32_t count_;
+    uint64_t sum_;
+    uint32_t min_;
+    uint32_t max_;
+};
@@ -4,7 +4,6 @@
 #include <cstddef>
 #include <vector>
 
-#include "MutexCPP.h"
 #include "elog.h"
 #include "hptimer.hpp"
 #include "udp_task.h"
@@ -12,7 +11,10 @@
 
 // MasterServer 构造函数实现
 MasterServer::MasterServer()
-    : pendingCommandsMutex("PendingCommandsMutex"), lastSyncTime(0), initialTimeSyncCompleted(false)
+    : inboxDropCount(0), uwbConsecutiveFailures(0), uwbLastFailureTime(0), lastSyncTime(0),
+      initialTimeSyncCompleted(false), lastSyncStampUs(0), lastSyncTxSeq(0), syncTxLatencyUs(0), phyAdaptive(false),
+      phyAdaptLastCheck(0), phyAdaptGoodWindows(0), phyAdaptPingsSent(0), phyAdaptPending(false),
+      phyAdaptPrevProfile(0), phyAdaptSilentWindows(0), phyAdaptBlockedProfile(UWB_PHY_PROFILE_NUM)
 {
     initializeMessageHandlers();
     initializeSlave2MasterHandlers();
@@ -45,6 +47,12 @@ void MasterServer::initializeMessageHandlers()
         &ClearDeviceListHandler::getInstance();
     messageHandlers_[static_cast<uint8_t>(Backend2MasterMessageId::SET_UWB_CHAN_MSG)] =
         &SetUwbChannelHandler::getInstance();
+    messageHandlers_[static_cast<uint8_t>(Backend2MasterMessageId::LINK_STATS_REQ_MSG)] =
+        &LinkStatsHandler::getInstance();
+    messageHandlers_[static_cast<uint8_t>(Backend2MasterMessageId::PHY_PROFILE_CFG_MSG)] =
+        &PhyProfileHandler::getInstance();
+    messageHandlers_[static_cast<uint8_t>(Backend2MasterMessageId::UWB_BENCH_CTRL_MSG)] =
+        &UwbBenchHandler::getInstance();
 }
 
 void MasterServer::initializeSlave2MasterHandlers()
@@ -128,7 +136,7 @@ void MasterServer::sendResponseToBackend(std::unique_ptr<Message> response)
     }
 }
 
-void MasterServer::sendCommandToSlave(uint32_t slaveId, std::unique_ptr<Message> command)
+void MasterServer::sendCommandToSlave(uint32_t slaveId, std::unique_ptr<Message> command, uwb_tx_class_t txClass)
 {
     if (!command)
         return;
@@ -140,7 +148,7 @@ void MasterServer::sendCommandToSlave(uint32_t slaveId, std::unique_ptr<Message>
     bool sendSuccess = true;
     for (auto &fragment : commandData)
     {
-        if (!sendToSlave(fragment))
+        if (!sendToSlave(fragment, txClass))
         {
             elog_e(TAG, "Failed to send command fragment");
             sendSuccess = false;
@@ -175,20 +183,14 @@ void MasterServer::sendCommandToSlaveWithRetry(uint32_t slaveId, std::unique_ptr
         sendCommandToSlave(slaveId, std::move(messageCopy));
     }
 
-    // Add to pending commands list for retry management (with mutex protection)
-    {
-        Lock lock(pendingCommandsMutex);
-        pendingCommands.push_back(std::move(pendingCmd));
-    }
+    // Add to pending commands list for retry management
+    pendingCommands.push_back(std::move(pendingCmd));
 
     elog_v(TAG, "Command sent to slave 0x%08X with retry support (max retries: %d)", slaveId, maxRetries);
 }
 
 void MasterServer::processPendingCommands()
 {
-    // Lock the mutex to prevent race conditions with removePendingCommand
-    Lock lock(pendingCommandsMutex);
-
     uint32_t currentTime = getCurrentTimestampMs();
     constexpr uint32_t BASE_RETRY_TIMEOUT = BASE_RETRY_TIMEOUT_MS; // 基础重试超时时间
 
@@ -207,6 +209,7 @@ void MasterServer::processPendingCommands()
                 // Retry the command
                 it->retryCount++;
                 it->timestamp = currentTime;
+                deviceManager.recordSlaveRetry(it->slaveId);
 
                 // Create a copy of the command by serializing and deserializing
                 auto serialized = it->command->serialize();
@@ -222,7 +225,7 @@ void MasterServer::processPendingCommands()
                     sendSuccess = true;
                     for (auto &fragment : commandData)
                     {
-                        if (!sendToSlave(fragment))
+                        if (!sendToSlave(fragment, UWB_TX_CLASS_RETRY))
                         {
                             elog_e(TAG, "Failed to send command fragment during retry");
                             sendSuccess = false;
@@ -243,6 +246,7 @@ void MasterServer::processPendingCommands()
                                "retries due to UWB errors",
                                it->slaveId, it->maxRetries);
 
+                        deviceManager.recordSlaveRetryOutcome(it->slaveId, false);
                         it = pendingCommands.erase(it);
                         continue;
                     }
@@ -262,7 +266,7 @@ void MasterServer::processPendingCommands()
                 elog_w(TAG, "Command to slave 0x%08X failed after %d retries", it->slaveId, it->maxRetries);
 
                 // 命令重试失败，移除待处理命令
-
+                deviceManager.recordSlaveRetryOutcome(it->slaveId, false);
                 it = pendingCommands.erase(it);
             }
         }
@@ -275,15 +279,16 @@ void MasterServer::processPendingCommands()
 
 void MasterServer::removePendingCommand(uint32_t slaveId, uint8_t commandMessageId)
 {
-    // Lock the mutex to prevent race conditions with processPendingCommands
-    Lock lock(pendingCommandsMutex);
-
     auto it = pendingCommands.begin();
     while (it != pendingCommands.end())
     {
         if (it->slaveId == slaveId && it->command->getMessageId() == commandMessageId)
         {
             elog_v(TAG, "Removing pending command for slave 0x%08X (msgId=0x%02X)", slaveId, commandMessageId);
+            if (it->retryCount > 0)
+            {
+                deviceManager.recordSlaveRetryOutcome(slaveId, true);
+            }
             it = pendingCommands.erase(it);
             break; // 只移除第一个匹配的命令
         }
@@ -296,9 +301,6 @@ void MasterServer::removePendingCommand(uint32_t slaveId, uint8_t commandMessage
 
 void MasterServer::clearAllPendingCommands()
 {
-    // Lock the mutex to prevent race conditions
-    Lock lock(pendingCommandsMutex);
-
     if (!pendingCommands.empty())
     {
         elog_v(TAG, "Clearing %d pending commands", pendingCommands.size());
@@ -682,9 +684,14 @@ void MasterServer::processPingSessions()
                 // Send ping command
                 auto pingCmd = std::make_unique<Master2Slave::PingReqMessage>();
                 pingCmd->sequenceNumber = it->currentCount + 1;
-                pingCmd->timestamp = currentTime;
+                // RTT按序列号用主机记录的发送时刻计算，从机的Ping Rsp时间戳是其自身的回复时刻
+                uint64_t sendUs = getCurrentTimestampUs();
+                pingCmd->timestamp = static_cast<uint32_t>(sendUs);
+                it->sendHistory.record(pingCmd->sequenceNumber, sendUs);
 
-                sendCommandToSlave(it->targetId, std::move(pingCmd));
+                sendCommandToSlave(it->targetId, std::move(pingCmd), UWB_TX_CLASS_PING);
+                deviceManager.recordSlavePingSent(it->targetId);
+                phyAdaptPingsSent++;
 
                 it->currentCount++;
                 it->lastPingTime = currentTime;
@@ -713,6 +720,25 @@ void MasterServer::processPingSessions()
                         response->successCount = it->successCount; // Use actual success count
                         response->destinationId = it->targetId;
 
+                        for (const auto &entry : it->slaveStats)
+                        {
+                            const LatencyHistogram &rtt = entry.second.rttUs;
+                            Master2Backend::PingResponseMessage::SlaveRttInfo info;
+                            info.slaveId = entry.first;
+                            info.successCount = entry.second.successCount;
+                            info.minRttUs = rtt.min();
+                            info.meanRttUs = rtt.mean();
+                            info.maxRttUs = rtt.max();
+                            info.p50RttUs = rtt.percentile(50);
+                            info.p99RttUs = rtt.percentile(99);
+                            response->slaves.push_back(info);
+
+                            elog_i(TAG, "Ping RTT slave 0x%08X: n=%d min=%lu mean=%lu max=%lu p50=%lu p99=%lu us",
+                                   info.slaveId, info.successCount, info.minRttUs, info.meanRttUs, info.maxRttUs,
+                                   info.p50RttUs, info.p99RttUs);
+                        }
+                        response->slaveNum = static_cast<uint8_t>(response->slaves.size());
+
                         sendResponseToBackend(std::move(response));
                         elog_i(TAG,
                                "Sent ping response to backend for target "
@@ -731,6 +757,177 @@ void MasterServer::processPingSessions()
     }
 }
 
+bool MasterServer::startUwbBench(uint32_t targetId, uint16_t packetSize, uint16_t count, uint16_t interval)
+{
+    if (uwbBench)
+    {
+        elog_w(TAG, "UWB bench already running for target 0x%08X", uwbBench->targetId);
+        return false;
+    }
+    if (targetId == BROADCAST_SLAVE_ID || count == 0 || count > UWB_BENCH_MAX_COUNT || packetSize > FRAME_LEN_MAX)
+    {
+        elog_w(TAG, "Invalid UWB bench request: target 0x%08X, size %d, count %d", targetId, packetSize, count);
+        return false;
+    }
+
+    // 以不带填充的Ping请求帧长为基准计算填充长度，请求包长小于基准时按基准发送
+    Master2Slave::PingReqMessage probe;
+    probe.sequenceNumber = 0;
+    probe.timestamp = 0;
+    auto frames = processor.packMaster2SlaveMessage(targetId, probe);
+    if (frames.size() != 1)
+        return false;
+
+    uint16_t baseSize = static_cast<uint16_t>(frames[0].size());
+    uint16_t padding = (packetSize > baseSize) ? packetSize - baseSize : 0;
+
+    // 从机按原样回传Ping Rsp，不带填充，响应方向按其帧长单独计算吞吐
+    Slave2Master::PingRspMessage rspProbe;
+    rspProbe.sequenceNumber = 0;
+    rspProbe.timestamp = 0;
+    auto rspFrames = processor.packSlave2MasterMessage(targetId, rspProbe);
+    if (rspFrames.size() != 1)
+        return false;
+
+    uwbBench = std::make_unique<UwbBenchSession>(targetId, baseSize + padding, padding, count, interval);
+    uwbBench->responseSize = static_cast<uint16_t>(rspFrames[0].size());
+    uwbBench->lastActivityTime = getCurrentTimestampMs();
+
+    elog_i(TAG, "UWB bench started: target 0x%08X, size %d, count %d, interval %dms", targetId, uwbBench->packetSize,
+           count, interval);
+    return true;
+}
+
+bool MasterServer::stopUwbBench()
+{
+    if (!uwbBench)
+        return false;
+
+    finishUwbBench(UWB_BENCH_STATUS_ABORTED);
+    return true;
+}
+
+void MasterServer::processUwbBench()
+{
+    if (!uwbBench)
+        return;
+
+    UwbBenchSession &bench = *uwbBench;
+    uint32_t currentTime = getCurrentTimestampMs();
+
+    // 只在Ping类别发送队列有空位时投递，不阻塞主循环，也不挤占其他类别
+    while (bench.sentCount < bench.totalCount)
+    {
+        if (bench.interval != 0 && bench.sentCount != 0 && currentTime - bench.lastSendTime < bench.interval)
+            break;
+
+        uwb_tx_class_stats_t stats;
+        if (UWB_GetTxClassStats(UWB_TX_CLASS_PING, &stats) != 0 || stats.count >= stats.depth)
+            break;
+
+        Master2Slave::PingReqMessage req;
+        req.sequenceNumber = static_cast<uint16_t>(UWB_BENCH_SEQ_FLAG | bench.sentCount);
+        uint64_t nowUs = getCurrentTimestampUs();
+        req.timestamp = static_cast<uint32_t>(nowUs);
+        req.paddingLength = bench.paddingLength;
+
+        auto frames = processor.packMaster2SlaveMessage(bench.targetId, req);
+        if (frames.size() != 1 || !sendToSlave(frames[0], UWB_TX_CLASS_PING))
+            break;
+
+        if (bench.sentCount == 0)
+            bench.firstSendUs = nowUs;
+        bench.sendHistory.record(bench.sentCount, nowUs);
+        bench.sentCount++;
+        bench.lastSendTime = currentTime;
+        bench.lastActivityTime = currentTime;
+
+        if (bench.interval != 0)
+            break;
+    }
+
+    if (bench.sentCount >= bench.totalCount &&
+        (bench.receivedCount >= bench.sentCount || currentTime - bench.lastActivityTime >= UWB_BENCH_DRAIN_MS))
+    {
+        finishUwbBench(UWB_BENCH_STATUS_COMPLETE);
+    }
+    else if (currentTime - bench.lastActivityTime >= UWB_BENCH_STALL_TIMEOUT_MS)
+    {
+        elog_w(TAG, "UWB bench stalled at %d/%d sent", bench.sentCount, bench.totalCount);
+        finishUwbBench(UWB_BENCH_STATUS_ABORTED);
+    }
+}
+
+void MasterServer::handleUwbBenchResponse(uint32_t slaveId, uint16_t sequenceNumber, uint64_t rxTimeUs)
+{
+    if (!uwbBench || uwbBench->targetId != slaveId)
+        return;
+
+    uint16_t index = static_cast<uint16_t>(sequenceNumber & ~UWB_BENCH_SEQ_FLAG);
+    if (!uwbBench->markReceived(index))
+        return;
+
+    uwbBench->lastRxUs = rxTimeUs;
+    uwbBench->lastActivityTime = getCurrentTimestampMs();
+
+    // 发送记录已被覆盖的迟到响应只计入收包
+    uint64_t sendUs;
+    if (uwbBench->sendHistory.find(index, sendUs) && rxTimeUs >= sendUs && rxTimeUs - sendUs <= PING_RTT_MAX_US)
+    {
+        uwbBench->rttUs.record(static_cast<uint32_t>(rxTimeUs - sendUs));
+    }
+}
+
+void MasterServer::finishUwbBench(uint8_t status)
+{
+    if (!uwbBench)
+        return;
+
+    const UwbBenchSession &bench = *uwbBench;
+    const LatencyHistogram &rtt = bench.rttUs;
+
+    // 有效时长：首帧发出到最后一个响应到达
+    uint64_t durationUs =
+        (bench.receivedCount != 0 && bench.lastRxUs > bench.firstSendUs) ? bench.lastRxUs - bench.firstSendUs : 0;
+
+    auto result = std::make_unique<Master2Backend::UwbBenchResultMessage>();
+    result->status = status;
+    result->targetId = bench.targetId;
+    result->packetSize = bench.packetSize;
+    result->totalCount = bench.totalCount;
+    result->sentCount = bench.sentCount;
+    result->receivedCount = bench.receivedCount;
+    result->lostCount = bench.sentCount - bench.receivedCount;
+    result->reorderedCount = bench.reorderedCount;
+    result->duplicateCount = bench.duplicateCount;
+    result->durationMs = static_cast<uint32_t>(durationUs / 1000);
+    // 两个方向分别统计：请求带填充，响应不带填充
+    result->txThroughputBps =
+        durationUs ? static_cast<uint32_t>(static_cast<uint64_t>(bench.receivedCount) * bench.packetSize * 8 *
+                                           1000000 / durationUs)
+                   : 0;
+    result->rxThroughputBps =
+        durationUs ? static_cast<uint32_t>(static_cast<uint64_t>(bench.receivedCount) * bench.responseSize * 8 *
+                                           1000000 / durationUs)
+                   : 0;
+    result->minRttUs = rtt.min();
+    result->p50RttUs = rtt.percentile(50);
+    result->p90RttUs = rtt.percentile(90);
+    result->p99RttUs = rtt.percentile(99);
+    result->maxRttUs = rtt.max();
+
+    elog_i(TAG, "UWB bench 0x%08X: status=%d sent=%d recv=%d lost=%d reorder=%d dup=%d %lu ms", bench.targetId,
+           status, result->sentCount, result->receivedCount, result->lostCount, result->reorderedCount,
+           result->duplicateCount, result->durationMs);
+    elog_i(TAG, "UWB bench throughput: tx %lu bps (%d B/frame), rx %lu bps (%d B/frame)", result->txThroughputBps,
+           bench.packetSize, result->rxThroughputBps, bench.responseSize);
+    elog_i(TAG, "UWB bench RTT: min=%lu p50=%lu p90=%lu p99=%lu max=%lu us", result->minRttUs, result->p50RttUs,
+           result->p90RttUs, result->p99RttUs, result->maxRttUs);
+
+    sendResponseToBackend(std::move(result));
+    uwbBench.reset();
+}
+
 void MasterServer::processBackend2MasterMessage(const Message &message)
 {
     elog_i(TAG, "Received Backend2Master message: %s", message.getMessageTypeName());
@@ -798,17 +995,41 @@ void MasterServer::processSlave2MasterMessage(uint32_t slaveId, const Message &m
     }
 }
 
-void MasterServer::processFrame(Frame &frame)
+bool MasterServer::postEvent(MasterEvent &&event)
+{
+    if (!inbox.push(std::move(event)))
+    {
+        uint32_t dropped = inboxDropCount.fetch_add(1, std::memory_order_relaxed) + 1;
+        elog_w(TAG, "MainTask inbox full, event dropped (total dropped: %lu)", dropped);
+        return false;
+    }
+
+    // 唤醒MainTask处理事件
+    if (mainTask)
+    {
+        mainTask->give();
+    }
+    return true;
+}
+
+void MasterServer::postFrame(ProtocolProcessor &parser, Frame &frame, const LinkRxInfo *rxInfo)
 {
-    elog_v(TAG, "Processing frame - PacketId: 0x%02X, payload size: %d", static_cast<int>(frame.packetId),
+    elog_v(TAG, "Posting frame - PacketId: 0x%02X, payload size: %d", static_cast<int>(frame.packetId),
            frame.payload.size());
 
+    MasterEvent event;
+    if (rxInfo)
+    {
+        event.hasRxInfo = true;
+        event.rxInfo = *rxInfo;
+    }
+
     if (frame.packetId == static_cast<uint8_t>(PacketId::BACKEND_TO_MASTER))
     {
-        std::unique_ptr<Message> backendMessage;
-        if (processor.parseBackend2MasterPacket(frame.payload, backendMessage))
+        if (parser.parseBackend2MasterPacket(frame.payload, event.message))
         {
-            processBackend2MasterMessage(*backendMessage);
+            event.type = MasterEvent::Type::BACKEND_MESSAGE;
+            postEvent(std::move(event));
         }
         else
         {
@@ -817,11 +1038,10 @@ void MasterServer::processFrame(Frame &frame)
     }
     else if (frame.packetId == static_cast<uint8_t>(PacketId::SLAVE_TO_MASTER))
     {
-        uint32_t slaveId;
-        std::unique_ptr<Message> slaveMessage;
-        if (processor.parseSlave2MasterPacket(frame.payload, slaveId, slaveMessage))
+        if (parser.parseSlave2MasterPacket(frame.payload, event.slaveId, event.message))
         {
-            processSlave2MasterMessage(slaveId, *slaveMessage);
+            event.type = MasterEvent::Type::SLAVE_MESSAGE;
+            postEvent(std::move(event));
         }
         else
         {
@@ -831,7 +1051,7 @@ void MasterServer::processFrame(Frame &frame)
     else if (frame.packetId == static_cast<uint8_t>(PacketId::SLAVE_TO_BACKEND))
     {
         // SLAVE_TO_BACKEND帧现在在SlaveDataProcT中直接透传，这里不再处理
-        elog_v(TAG, "SLAVE_TO_BACKEND frame ignored in processFrame (handled in "
+        elog_v(TAG, "SLAVE_TO_BACKEND frame ignored in postFrame (handled in "
                     "SlaveDataProcT)");
     }
     else
@@ -840,6 +1060,48 @@ void MasterServer::processFrame(Frame &frame)
     }
 }
 
+bool MasterServer::processInbox()
+{
+    MasterEvent event;
+    for (int i = 0; i < MASTER_INBOX_DRAIN_MAX; i++)
+    {
+        if (!inbox.pop(event))
+        {
+            return false;
+        }
+        dispatchEvent(event);
+        event.message.reset();
+    }
+    return true; // 本轮达到处理上限，可能还有剩余事件
+}
+
+void MasterServer::dispatchEvent(MasterEvent &event)
+{
+    const LinkRxInfo *rxInfo = event.hasRxInfo ? &event.rxInfo : nullptr;
+
+    switch (event.type)
+    {
+    case MasterEvent::Type::BACKEND_MESSAGE:
+        if (event.message)
+        {
+            processBackend2MasterMessage(*event.message);
+        }
+        break;
+    case MasterEvent::Type::SLAVE_MESSAGE:
+        deviceManager.recordSlaveRx(event.slaveId, rxInfo);
+        if (event.message)
+        {
+            currentRxInfo = rxInfo;
+            processSlave2MasterMessage(event.slaveId, *event.message);
+            currentRxInfo = nullptr;
+        }
+        break;
+    case MasterEvent::Type::SLAVE_RX:
+        deviceManager.recordSlaveRx(event.slaveId, rxInfo);
+        break;
+    }
+}
+
 // 数据采集管理
 void MasterServer::startSlaveDataCollection()
 {
@@ -864,6 +1126,20 @@ void MasterServer::processTimeSync()
         return;
     }
 
+    // 用上一帧同步消息的实际发送时刻更新发送延迟估计（排队 + SPI + 芯片启动）
+    uwb_tx_time_t txTime;
+    if (UWB_GetLastSyncTxTime(&txTime) == 0 && txTime.seq != lastSyncTxSeq)
+    {
+        lastSyncTxSeq = txTime.seq;
+        if (lastSyncStampUs != 0 && txTime.tx_time_us >= lastSyncStampUs &&
+            txTime.tx_time_us - lastSyncStampUs <= SYNC_TX_LATENCY_MAX_US)
+        {
+            uint32_t latencyUs = static_cast<uint32_t>(txTime.tx_time_us - lastSyncStampUs);
+            // 指数平滑，首个样本直接采用
+            syncTxLatencyUs = (syncTxLatencyUs == 0) ? latencyUs : (syncTxLatencyUs * 7 + latencyUs) / 8;
+        }
+    }
+
     uint32_t currentTime = getCurrentTimestampMs();
 
     // 计算TDMA周期长度: 延迟启动时间 + 总时隙数量 × interval + 额外延迟
@@ -896,8 +1172,10 @@ void MasterServer::processTimeSync()
         syncCmd->interval = dm.getEffectiveInterval();
 
         // 当前时间和启动时间（微秒）
+        // currentTime补偿发送延迟，使其接近同步帧实际离开天线的时刻
         uint64_t timestampUs = hal_hptimer_get_us64();
-        syncCmd->currentTime = timestampUs;
+        syncCmd->currentTime = timestampUs + syncTxLatencyUs;
+        lastSyncStampUs = timestampUs;
 
         // 启动时间设置为当前时间加上启动延迟时间
         syncCmd->startTime = timestampUs + (startupDelayMs * 1000);
@@ -906,14 +1184,14 @@ void MasterServer::processTimeSync()
         buildSlaveConfigsForSync(*syncCmd, dm);
 
         // 广播发送统一同步消息（使用广播地址）
-        sendCommandToSlave(BROADCAST_SLAVE_ID, std::move(syncCmd));
+        sendCommandToSlave(BROADCAST_SLAVE_ID, std::move(syncCmd), UWB_TX_CLASS_SYNC);
 
         lastSyncTime = currentTime;
 
         elog_v(TAG,
                "Broadcasted TDMA sync message (mode=%d, interval=%d ms, "
                "current_time=%lu us, start_time=%lu us, slaves=%d, cycle=%lu ms)",
-               dm.getCurrentMode(), dm.getEffectiveInterval(), (unsigned long)timestampUs,
+               dm.getCurrentMode(), dm.getEffectiveInterval(), (unsigned long)(timestampUs + syncTxLatencyUs),
                (unsigned long)(timestampUs + startupDelayMs * 1000), static_cast<int>(totalTimeSlots),
                (unsigned long)tdmaCycleMs);
     }
@@ -980,9 +1258,21 @@ bool MasterServer::sendToBackend(std::vector<uint8_t> &frame)
 {
     // 数据通过UDP_SendData发送
     int result = UDP_SendData(frame.data(), frame.size(), DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT);
+    return checkBackendSendResult(result, frame.size());
+}
+
+bool MasterServer::sendToBackend(frame_buf_t *buf)
+{
+    size_t len = buf ? buf->len : 0;
+    int result = UDP_SendReliable(buf, DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT);
+    return checkBackendSendResult(result, len);
+}
+
+bool MasterServer::checkBackendSendResult(int result, size_t len)
+{
     if (result == 0)
     {
-        elog_v(TAG, "sendToBackend success (%d bytes to %s:%d)", static_cast<int>(frame.size()), DEFAULT_BACKEND_IP,
+        elog_v(TAG, "sendToBackend success (%d bytes to %s:%d)", static_cast<int>(len), DEFAULT_BACKEND_IP,
                DEFAULT_BACKEND_PORT);
         return true;
     }
@@ -1001,67 +1291,219 @@ bool MasterServer::sendToBackend(std::vector<uint8_t> &frame)
         case -3:
             errorMsg = "UDP TX queue full or timeout";
             break;
+        case -4:
+            errorMsg = "Frame buffer pool exhausted";
+            break;
         }
         elog_e(TAG, "sendToBackend failed: %s (error code: %d, size: %d, target: %s:%d)", errorMsg, result,
-               static_cast<int>(frame.size()), DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT);
+               static_cast<int>(len), DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT);
 
-        // 如果是队列满的问题，尝试清理队列
+        // 队列满只丢弃本帧，已排队的帧照常发送，由UDP任务自行排空
         if (result == -3)
         {
-            int queueCount = UDP_GetTxQueueCount();
-            elog_w(TAG, "UDP TX queue count: %d/10, considering queue cleanup", queueCount);
-            if (queueCount >= 8) // 队列接近满时清理
-            {
-                UDP_ClearTxQueue();
-                elog_w(TAG, "UDP TX queue cleared due to congestion");
-            }
+            elog_w(TAG, "UDP TX queue count: %d/%d", UDP_GetTxQueueCount(), UDP_GetTxQueueCapacity());
         }
 
         return false;
     }
 }
 
-bool MasterServer::sendToSlave(std::vector<uint8_t> &frame)
+bool MasterServer::sendToSlave(std::vector<uint8_t> &frame, uwb_tx_class_t txClass)
 {
-    static uint32_t consecutiveFailures = 0;
-    static uint32_t lastFailureTime = 0;
     const uint32_t MAX_CONSECUTIVE_FAILURES = MAX_CONSECUTIVE_UWB_FAILURES;
     const uint32_t FAILURE_RESET_INTERVAL = UWB_FAILURE_RESET_INTERVAL_MS;
 
     uint32_t currentTime = getCurrentTimestampMs();
 
     // 如果距离上次失败超过30秒，重置失败计数
-    if (currentTime - lastFailureTime > FAILURE_RESET_INTERVAL)
+    if (currentTime - uwbLastFailureTime > FAILURE_RESET_INTERVAL)
     {
-        consecutiveFailures = 0;
+        uwbConsecutiveFailures = 0;
     }
 
-    // 如果连续失败次数过多，暂时停止发送
-    if (consecutiveFailures >= MAX_CONSECUTIVE_FAILURES)
+    // 如果连续失败次数过多，暂时停止发送（同步帧除外，保证TDMA时序）
+    if (uwbConsecutiveFailures >= MAX_CONSECUTIVE_FAILURES && txClass != UWB_TX_CLASS_SYNC)
     {
         elog_w(TAG,
                "Too many consecutive UWB failures (%d), temporarily stopping "
                "transmission",
-               consecutiveFailures);
+               uwbConsecutiveFailures);
         return false;
     }
 
     // send data by uwb
-    if (UWB_SendData(frame.data(), frame.size(), 0) == 0)
+    int result = UWB_SendDataPrio(frame.data(), frame.size(), txClass);
+    if (result == 0)
     {
         elog_i(TAG, "sendToSlave success");
     }
+    else if (txClass == UWB_TX_CLASS_RETRY || txClass == UWB_TX_CLASS_PING)
+    {
+        // 尽力而为类别被丢弃属于正常的流量整形，不计入UWB失败
+        elog_w(TAG, "sendToSlave dropped (class %d queue full)", static_cast<int>(txClass));
+        return false;
+    }
     else
     {
-        elog_e(TAG, "sendToSlave failed");
+        uwbConsecutiveFailures++;
+        uwbLastFailureTime = currentTime;
+        elog_e(TAG, "sendToSlave failed (class %d, error %d, consecutive failures %d)", static_cast<int>(txClass),
+               result, uwbConsecutiveFailures);
         return false;
     }
 
     // 发送成功，重置失败计数
-    consecutiveFailures = 0;
+    uwbConsecutiveFailures = 0;
     return true;
 }
 
+void MasterServer::logUwbTxStats()
+{
+    static const char *const classNames[UWB_TX_CLASS_NUM] = {"sync", "control", "retry", "ping"};
+
+    for (int i = 0; i < UWB_TX_CLASS_NUM; i++)
+    {
+        uwb_tx_class_stats_t stats;
+        if (UWB_GetTxClassStats(static_cast<uwb_tx_class_t>(i), &stats) == 0)
+        {
+            elog_i(TAG, "UWB TX %s: enq=%lu sent=%lu drop=%lu queued=%d/%d peak=%d", classNames[i], stats.enqueued,
+                   stats.sent, stats.dropped, stats.count, stats.depth, stats.highWater);
+        }
+    }
+}
+
+void MasterServer::setPhyAdaptive(bool enable)
+{
+    phyAdaptive = enable;
+    phyAdaptGoodWindows = 0;
+    phyAdaptLastCheck = getCurrentTimestampMs();
+    phyAdaptPingsSent = 0;
+    phyAdaptPending = false;
+    phyAdaptSilentWindows = 0;
+    phyAdaptBlockedProfile = UWB_PHY_PROFILE_NUM;
+
+    // 以当前计数为基准，丢弃开启前的历史
+    phyAdaptSamples.clear();
+    for (const auto &entry : deviceManager.getAllLinkStats())
+    {
+        phyAdaptSamples[entry.first] = {entry.second.pingsSent, entry.second.pingResponses};
+    }
+}
+
+void MasterServer::processPhyAdaptation()
+{
+    if (!phyAdaptive)
+        return;
+
+    uint32_t currentTime = getCurrentTimestampMs();
+    if (currentTime - phyAdaptLastCheck < PHY_ADAPT_INTERVAL_MS)
+        return;
+    phyAdaptLastCheck = currentTime;
+
+    uint32_t windowPings = phyAdaptPingsSent;
+    phyAdaptPingsSent = 0;
+
+    // 本周期内每个从机的Ping丢包率（按发出的请求数计算），取最差值
+    uint32_t worstLoss = 0;
+    uint32_t windowResponses = 0;
+    bool hasSamples = false;
+    for (const auto &entry : deviceManager.getAllLinkStats())
+    {
+        const SlaveLinkStats &stats = entry.second;
+        PhyAdaptSample &last = phyAdaptSamples[entry.first];
+
+        // 统计被清零后计数会回退，此时以0为基准
+        uint32_t sent = (stats.pingsSent >= last.pingsSent) ? stats.pingsSent - last.pingsSent : stats.pingsSent;
+        uint32_t responses = (stats.pingResponses >= last.pingResponses) ? stats.pingResponses - last.pingResponses
+                                                                         : stats.pingResponses;
+        last = {stats.pingsSent, stats.pingResponses};
+        windowResponses += responses;
+
+        if (sent < PHY_ADAPT_MIN_SAMPLES)
+            continue;
+
+        // 上一周期末发出的请求可能在本周期响应
+        if (responses > sent)
+            responses = sent;
+
+        uint32_t loss = (sent - responses) * 1000 / sent;
+        if (loss > worstLoss)
+            worstLoss = loss;
+        hasSamples = true;
+    }
+
+    uwb_radio_state_t radio;
+    if (UWB_GetRadioState(&radio) != 0)
+    {
+        phyAdaptGoodWindows = 0;
+        return;
+    }
+
+    // 档位只切换主机，从机不在新档位上时切换后将收不到任何响应：确认有响应前不做新的切换，
+    // 连续PHY_ADAPT_REVERT_WINDOWS个周期发出Ping却无响应则退回原档位，本次自适应期间不再尝试该档位
+    if (phyAdaptPending)
+    {
+        if (windowResponses > 0)
+        {
+            phyAdaptPending = false;
+        }
+        else
+        {
+            phyAdaptGoodWindows = 0;
+            if (windowPings > 0 && ++phyAdaptSilentWindows >= PHY_ADAPT_REVERT_WINDOWS)
+            {
+                elog_w(TAG, "PHY adapt: no ping response on profile %d, reverting to %d", radio.profile,
+                       phyAdaptPrevProfile);
+                phyAdaptBlockedProfile = radio.profile;
+                phyAdaptPending = false;
+                UWB_SetPhyProfile(static_cast<uwb_phy_profile_t>(phyAdaptPrevProfile));
+            }
+            return;
+        }
+    }
+
+    if (!hasSamples)
+    {
+        phyAdaptGoodWindows = 0;
+        return;
+    }
+
+    if (worstLoss >= PHY_ADAPT_DEGRADE_LOSS_PERMILLE)
+    {
+        phyAdaptGoodWindows = 0;
+        if (radio.profile + 1 < UWB_PHY_PROFILE_NUM && radio.profile + 1 != phyAdaptBlockedProfile)
+        {
+            elog_w(TAG, "PHY adapt: worst loss %lu permille, profile %d -> %d", worstLoss, radio.profile,
+                   radio.profile + 1);
+            switchPhyProfileAdaptive(radio.profile, radio.profile + 1);
+        }
+    }
+    else if (worstLoss <= PHY_ADAPT_UPGRADE_LOSS_PERMILLE)
+    {
+        if (++phyAdaptGoodWindows >= PHY_ADAPT_UPGRADE_WINDOWS && radio.profile > UWB_PHY_PROFILE_HIGH_THROUGHPUT &&
+            radio.profile - 1 != phyAdaptBlockedProfile)
+        {
+            elog_i(TAG, "PHY adapt: link stable, profile %d -> %d", radio.profile, radio.profile - 1);
+            switchPhyProfileAdaptive(radio.profile, radio.profile - 1);
+            phyAdaptGoodWindows = 0;
+        }
+    }
+    else
+    {
+        phyAdaptGoodWindows = 0;
+    }
+}
+
+void MasterServer::switchPhyProfileAdaptive(uint8_t from, uint8_t to)
+{
+    if (UWB_SetPhyProfile(static_cast<uwb_phy_profile_t>(to)) != 0)
+        return;
+
+    phyAdaptPending = true;
+    phyAdaptPrevProfile = from;
+    phyAdaptSilentWindows = 0;
+}
+
 // SlaveDataProcT 实现
 MasterServer::SlaveDataProcT::SlaveDataProcT(MasterServer &parent)
     : TaskClassS("SlaveDataProcT", TaskPrio_Mid), parent(parent)
@@ -1074,12 +1516,18 @@ void MasterServer::SlaveDataProcT::task()
     uwb_rx_msg_t msg;
     for (;;)
     {
-        if (UWB_ReceiveData(&msg, 0) == 0)
+        // 阻塞等待UWB任务投递的数据，不再轮询
+        if (UWB_ReceiveData(&msg, UWB_WAIT_FOREVER) == 0)
         {
             elog_v(TAG, "SlaveDataProcT recvData size: %d", msg.data_len);
-            // copy msg.data to recvData
+            // copy msg.data to recvData，缓冲块保留到处理结束，透传时直接交给UDP发送
             recvData.assign(msg.data, msg.data + msg.data_len);
 
+            LinkRxInfo rxInfo;
+            rxInfo.rssi = msg.rssi;
+            rxInfo.quality = msg.quality;
+            rxInfo.rxTimeUs = msg.rx_time_us;
+
             if (!recvData.empty())
             {
                 // 检查是否为SLAVE_TO_BACKEND帧，如果是则直接透传
@@ -1088,7 +1536,7 @@ void MasterServer::SlaveDataProcT::task()
                 while (pos < recvData.size())
                 {
                     // 查找帧头
-                    size_t frameStart = parent.processor.findFrameHeader(recvData, pos);
+                    size_t frameStart = parser.findFrameHeader(recvData, pos);
                     if (frameStart == SIZE_MAX)
                     {
                         break; // 没有找到更多帧头
@@ -1109,8 +1557,22 @@ void MasterServer::SlaveDataProcT::task()
                         elog_v(TAG, "Found SLAVE_TO_BACKEND frame, forwarding raw "
                                     "data");
 
-                        // 直接透传原始接收数据给后端
-                        if (parent.sendToBackend(recvData))
+                        // 载荷: Message ID(1) + Slave ID(4)，交给MainTask做链路统计
+                        if (frameStart + 12 <= recvData.size())
+                        {
+                            MasterEvent event;
+                            event.type = MasterEvent::Type::SLAVE_RX;
+                            event.slaveId = recvData[frameStart + 8] | (recvData[frameStart + 9] << 8) |
+                                            (recvData[frameStart + 10] << 16) |
+                                            (static_cast<uint32_t>(recvData[frameStart + 11]) << 24);
+                            event.hasRxInfo = true;
+                            event.rxInfo = rxInfo;
+                            parent.postEvent(std::move(event));
+                        }
+
+                        // 直接透传原始接收缓冲块给后端（零拷贝）
+                        FramePool_Retain(msg.buf);
+                        if (parent.sendToBackend(msg.buf))
                         {
                             elog_v(TAG,
                                    "Successfully forwarded raw SLAVE_TO_BACKEND "
@@ -1133,20 +1595,20 @@ void MasterServer::SlaveDataProcT::task()
                 if (!hasSlaveToBackendFrame)
                 {
                     // process recvData
-                    parent.processor.processReceivedData(recvData);
+                    parser.processReceivedData(recvData);
 
-                    // process complete frame
+                    // 解析完整帧并投递给MainTask
                     Frame receivedFrame;
-                    while (parent.processor.getNextCompleteFrame(receivedFrame))
+                    while (parser.getNextCompleteFrame(receivedFrame))
                     {
-                        parent.processFrame(receivedFrame);
+                        parent.postFrame(parser, receivedFrame, &rxInfo);
                     }
                 }
 
                 recvData.clear();
             }
+            UWB_ReleaseRxMsg(&msg);
         }
-        TaskBase::delay(1);
     }
 }
 
@@ -1162,35 +1624,35 @@ void MasterServer::BackDataProcT::task()
     udp_rx_msg_t msg;
     for (;;)
     {
-        if (UDP_ReceiveData(&msg, 0) == 0)
+        // 阻塞等待UDP任务投递的数据，不再轮询
+        if (UDP_ReceiveData(&msg, UDP_WAIT_FOREVER) == 0)
         {
-            // copy msg.data to recvData
-            recvData.assign(msg.data, msg.data + msg.data_len);
+            elog_v(TAG, "Backend recvData size: %d", msg.data_len);
 
-            if (!recvData.empty())
+            // 直接从以太网接收缓冲区逐段追加到解析器，解析器的重组缓冲区是唯一一次拷贝；追加完即归还pbuf
+            for (const struct pbuf *q = msg.p; q != NULL; q = q->next)
+            {
+                parser.processReceivedData(static_cast<const uint8_t *>(q->payload), q->len);
+            }
+            UDP_ReleaseRxMsg(&msg);
+
+            Frame receivedFrame;
+            while (parser.getNextCompleteFrame(receivedFrame))
             {
-                elog_v(TAG, "Backend recvData size: %d", recvData.size());
-                parent.processor.processReceivedData(recvData);
-                Frame receivedFrame;
-                while (parent.processor.getNextCompleteFrame(receivedFrame))
+                // 只处理来自后端的消息，不处理转发的从机数据
+                if (receivedFrame.packetId == static_cast<uint8_t>(PacketId::BACKEND_TO_MASTER))
                 {
-                    // 只处理来自后端的消息，不处理转发的从机数据
-                    if (receivedFrame.packetId == static_cast<uint8_t>(PacketId::BACKEND_TO_MASTER))
-                    {
-                        parent.processFrame(receivedFrame);
-                    }
-                    else
-                    {
-                        elog_w(TAG,
-                               "Ignoring non-backend frame (PacketId: 0x%02X) to "
-                               "prevent loopback",
-                               static_cast<int>(receivedFrame.packetId));
-                    }
+                    parent.postFrame(parser, receivedFrame);
+                }
+                else
+                {
+                    elog_w(TAG,
+                           "Ignoring non-backend frame (PacketId: 0x%02X) to "
+                           "prevent loopback",
+                           static_cast<int>(receivedFrame.packetId));
                 }
-                recvData.clear();
             }
         }
-        TaskBase::delay(1);
     }
 }
 
@@ -1205,16 +1667,26 @@ void MasterServer::MainTask::task()
 
     uint32_t lastDeviceCleanup = 0;
     uint32_t deviceCleanupInterval = DEVICE_CLEANUP_INTERVAL_MS; // 设备清理间隔
+    uint32_t lastUwbHealthCheck = 0;
 
+    bool inboxBacklog = false;
     for (;;)
     {
+        // 等待入口任务投递事件，超时后执行周期性处理
+        TaskBase::take(true, inboxBacklog ? 0 : pdMS_TO_TICKS(TASK_DELAY_MS));
+
+        // 处理入口任务投递的消息，所有状态修改都在本任务中完成
+        inboxBacklog = parent.processInbox();
+
         uint32_t currentTime = getCurrentTimestampMs();
 
         // Process pending commands, ping sessions, and data collection
         parent.processPendingCommands();
         parent.processPingSessions();
+        parent.processUwbBench();
         parent.processPendingBackendResponses();
         parent.processTimeSync();
+        parent.processPhyAdaptation();
 
         // 定期清理超时设备（删除而不是标记离线）
         if (currentTime - lastDeviceCleanup >= deviceCleanupInterval)
@@ -1223,7 +1695,12 @@ void MasterServer::MainTask::task()
             lastDeviceCleanup = currentTime;
         }
 
-        TaskBase::delay(TASK_DELAY_MS);
+        // 定期输出UWB发送队列统计
+        if (currentTime - lastUwbHealthCheck >= UWB_HEALTH_CHECK_INTERVAL_MS)
+        {
+            parent.logUwbTxStats();
+            lastUwbHealthCheck = currentTime;
+        }
     }
 }
 
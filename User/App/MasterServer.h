@@ -1,14 +1,37 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include "B2M_MessageHandlers.h"
 #include "CommandTracking.h"
 #include "DeviceManager.h"
-#include "MutexCPP.h"
+#include "MpscQueue.h"
 #include "S2M_MessageHandlers.h"
 #include "TaskCPP.h"
 #include "master_app.h"
+#include "uwb_task.h"
+
+// 入口任务投递给MainTask的事件，MainTask是MasterServer所有状态的唯一拥有者
+struct MasterEvent
+{
+    enum class Type : uint8_t
+    {
+        BACKEND_MESSAGE, // 已解析的Backend2Master消息
+        SLAVE_MESSAGE,   // 已解析的Slave2Master消息
+        SLAVE_RX         // 已透传的Slave2Backend帧，仅用于链路统计
+    };
+
+    Type type;
+    uint32_t slaveId;
+    bool hasRxInfo;
+    LinkRxInfo rxInfo;
+    std::unique_ptr<Message> message;
+
+    MasterEvent() : type(Type::BACKEND_MESSAGE), slaveId(0), hasRxInfo(false), rxInfo{}, message(nullptr)
+    {
+    }
+};
 
 class MasterServer
 {
@@ -19,31 +42,74 @@ class MasterServer
     constexpr static const char TAG[] = "MasterServer";
     constexpr static const uint32_t DataSend_TX_QUEUE_TIMEOUT = DATA_SEND_TX_QUEUE_TIMEOUT_MS;
 
+    // 以下状态只允许在MainTask中访问；入口任务只解析数据并通过inbox投递事件
     ProtocolProcessor processor;
     std::unordered_map<uint8_t, std::unique_ptr<IMessageHandler>> messageHandlers;
     std::vector<PendingCommand> pendingCommands;
     std::vector<PingSession> activePingSessions;
+    std::unique_ptr<UwbBenchSession> uwbBench; // 当前的UWB吞吐测试，空闲时为空
     std::vector<PendingBackendResponse> pendingBackendResponses;
     DeviceManager deviceManager;
 
-    // Mutex to protect pendingCommands from race conditions
-    Mutex pendingCommandsMutex;
+    // 入口任务 -> MainTask 的无锁事件队列
+    MpscQueue<MasterEvent, MASTER_INBOX_SIZE> inbox;
+    std::atomic<uint32_t> inboxDropCount;
 
     // 时间同步相关
     uint32_t lastSyncTime;
     bool initialTimeSyncCompleted; // 标记是否已完成初始时间同步
+    uint64_t lastSyncStampUs;      // 上一次同步帧写入的时间戳 (us)
+    uint32_t lastSyncTxSeq;        // 已处理的同步帧发送时刻序号
+    uint32_t syncTxLatencyUs;      // 同步帧从生成到实际发送的延迟估计 (us)
+
+    // 当前正在分发的Slave2Master消息的接收信息，仅在消息处理期间有效
+    const LinkRxInfo *getCurrentRxInfo() const
+    {
+        return currentRxInfo;
+    }
 
     /**
      * 运行主循环
      */
     void run();
 
+    // UWB发送健康状态（仅MainTask访问）
+    uint32_t uwbConsecutiveFailures;
+    uint32_t uwbLastFailureTime;
+
+    // UWB PHY档位自适应（仅MainTask访问）
+    struct PhyAdaptSample
+    {
+        uint32_t pingsSent;
+        uint32_t pingResponses;
+    };
+    bool phyAdaptive;
+    uint32_t phyAdaptLastCheck;
+    uint8_t phyAdaptGoodWindows;
+    std::unordered_map<uint32_t, PhyAdaptSample> phyAdaptSamples; // slaveId -> 上一周期的计数
+    uint32_t phyAdaptPingsSent;     // 本周期发出的Ping请求数（不区分目标）
+    bool phyAdaptPending;           // 自动切换后尚未收到任何Ping响应
+    uint8_t phyAdaptPrevProfile;    // 自动切换前的档位，切换后从机无响应时退回
+    uint8_t phyAdaptSilentWindows;  // 自动切换后连续无响应的周期数
+    uint8_t phyAdaptBlockedProfile; // 曾因从机无响应而退回的档位，本次自适应期间不再尝试
+
+    /**
+     * 开启/关闭PHY档位自适应
+     */
+    void setPhyAdaptive(bool enable);
+
     /**
      * 发送到从机
      * @param frame 要发送的数据帧
-     * @return 是否发送成功
+     * @param txClass 发送优先级类别
+     * @return 是否发送成功（尽力而为类别被丢弃时也返回false，但不计入UWB失败）
      */
-    bool sendToSlave(std::vector<uint8_t> &frame);
+    bool sendToSlave(std::vector<uint8_t> &frame, uwb_tx_class_t txClass = UWB_TX_CLASS_CONTROL);
+
+    /**
+     * 输出UWB各发送类别的统计
+     */
+    void logUwbTxStats();
 
     /**
      * 发送到后端
@@ -52,6 +118,19 @@ class MasterServer
      */
     bool sendToBackend(std::vector<uint8_t> &frame);
 
+    /**
+     * 零拷贝发送到后端，缓冲块直接交给以太网DMA
+     * 后端开启可靠传输时按序号发送并在丢失时重传
+     * @param buf 帧缓冲块，调用者转交一个引用
+     * @return 是否发送成功
+     */
+    bool sendToBackend(frame_buf_t *buf);
+
+    /**
+     * 检查UDP发送结果并输出诊断
+     */
+    bool checkBackendSendResult(int result, size_t len);
+
     /**
      * 后端到主机数据处理任务类 (处理从后端接收到的数据)
      */
@@ -62,6 +141,7 @@ class MasterServer
 
       private:
         MasterServer &parent;
+        ProtocolProcessor parser; // 本任务独立的帧重组状态
         std::vector<uint8_t> recvData;
         void task() override;
         static constexpr const char TAG[] = "SlaveDataProcT";
@@ -77,7 +157,7 @@ class MasterServer
 
       private:
         MasterServer &parent;
-        std::vector<uint8_t> recvData;
+        ProtocolProcessor parser; // 本任务独立的帧重组状态
         void task() override;
         static constexpr const char TAG[] = "BackDataProcT";
     };
@@ -101,14 +181,20 @@ class MasterServer
     // Utility methods
     uint32_t getCurrentTimestamp();
 
-    // Core processing methods
+    // Event inbox (ingress tasks -> MainTask)
+    bool postEvent(MasterEvent &&event);
+    void postFrame(ProtocolProcessor &parser, Frame &frame, const LinkRxInfo *rxInfo = nullptr);
+    bool processInbox();
+    void dispatchEvent(MasterEvent &event);
+
+    // Core processing methods (MainTask only)
     void processBackend2MasterMessage(const Message &message);
     void processSlave2MasterMessage(uint32_t slaveId, const Message &message);
-    void processFrame(Frame &frame);
 
     // Message sending methods
     void sendResponseToBackend(std::unique_ptr<Message> response);
-    void sendCommandToSlave(uint32_t slaveId, std::unique_ptr<Message> command);
+    void sendCommandToSlave(uint32_t slaveId, std::unique_ptr<Message> command,
+                            uwb_tx_class_t txClass = UWB_TX_CLASS_CONTROL);
     void sendCommandToSlaveWithRetry(uint32_t slaveId, std::unique_ptr<Message> command,
 
                                      uint8_t maxRetries = 3);
@@ -121,6 +207,13 @@ class MasterServer
                         std::unique_ptr<Message> originalMessage = nullptr);
     void processPingSessions();
 
+    // UWB吞吐测试
+    bool startUwbBench(uint32_t targetId, uint16_t packetSize, uint16_t count, uint16_t interval);
+    bool stopUwbBench();
+    void processUwbBench();
+    void handleUwbBenchResponse(uint32_t slaveId, uint16_t sequenceNumber, uint64_t rxTimeUs);
+    void finishUwbBench(uint8_t status);
+
     // Configuration response tracking
     void addPendingBackendResponse(uint8_t messageType, std::unique_ptr<Message> originalMessage,
                                    const std::vector<uint32_t> &targetSlaves);
@@ -130,6 +223,8 @@ class MasterServer
     // 数据采集管理
     void startSlaveDataCollection();
     void processTimeSync();
+    void processPhyAdaptation();
+    void switchPhyProfileAdaptive(uint8_t from, uint8_t to);
 
     // Device management
     DeviceManager &getDeviceManager()
@@ -157,4 +252,6 @@ class MasterServer
     ISlave2MasterMessageHandler *slave2MasterHandlers_[256] = {};
     void initializeMessageHandlers();
     void initializeSlave2MasterHandlers();
+
+    const LinkRxInfo *currentRxInfo = nullptr;
 };
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// 有界无锁多生产者/单消费者队列 (基于 Vyukov bounded queue)
+// 生产者之间通过 CAS 抢占写入位置，消费者只有一个，不需要原子读指针。
+// 每个槽位的 sequence 表示槽位状态：
+//   sequence == pos       槽位空闲，可由写入位置为 pos 的生产者写入
+//   sequence == pos + 1   槽位已写入，可由消费者读取
+// 不使用任何锁或临界区，可在多个任务中并发 push，但不能在中断中使用（T 的移动可能分配/释放内存）。
+template <typename T, size_t Capacity> class MpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+  public:
+    MpscQueue() : enqueuePos_(0), dequeuePos_(0)
+    {
+        for (size_t i = 0; i < Capacity; i++)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    // 生产者调用，队列满时返回false
+    bool push(T &&value)
+    {
+        Cell *cell;
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &cells_[pos & (Capacity - 1)];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // 队列满
+            }
+            else
+            {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 仅由唯一的消费者调用，队列空（或队首槽位尚未写完）时返回false
+    bool pop(T &value)
+    {
+        Cell *cell = &cells_[dequeuePos_ & (Capacity - 1)];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeuePos_ + 1) < 0)
+        {
+            return false;
+        }
+
+        value = std::move(cell->data);
+        cell->sequence.store(dequeuePos_ + Capacity, std::memory_order_release);
+        dequeuePos_++;
+        return true;
+    }
+
+    // 仅由消费者调用，近似值，用于统计
+    size_t size() const
+    {
+        return enqueuePos_.load(std::memory_order_relaxed) - dequeuePos_;
+    }
+
+    static constexpr size_t capacity()
+    {
+        return Capacity;
+    }
+
+  private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    Cell cells_[Capacity];
+    std::atomic<size_t> enqueuePos_;
+    size_t dequeuePos_;
+};
@@ -144,12 +144,43 @@ void PingResponseHandler::executeActions(uint32_t slaveId, const Message &messag
     elog_v("PingResponseHandler", "Received ping response from slave 0x%08X (seq=%d)", slaveId,
            pingRsp->sequenceNumber);
 
-    // Update ping session success count
+    // RTT = 接收时刻 - 主机记录的该序列号发送时刻；优先使用帧的接收时刻，排除主机侧排队和处理时间
+    // Ping Rsp中的时间戳是从机自身的回复时刻，不参与计算
+    const LinkRxInfo *rxInfo = server->getCurrentRxInfo();
+    uint64_t rxTimeUs = (rxInfo && rxInfo->rxTimeUs != 0) ? rxInfo->rxTimeUs : getCurrentTimestampUs();
+
+    // 吞吐测试的响应单独统计，不计入Ping会话和链路序号统计
+    if (pingRsp->sequenceNumber & UWB_BENCH_SEQ_FLAG)
+    {
+        server->handleUwbBenchResponse(slaveId, pingRsp->sequenceNumber, rxTimeUs);
+        return;
+    }
+
+    server->getDeviceManager().recordSlavePingSequence(slaveId, pingRsp->sequenceNumber);
+
+    // Update ping session success count and RTT statistics
     for (auto &session : server->activePingSessions)
     {
-        if (session.targetId == slaveId)
+        if (session.matchesSlave(slaveId))
         {
-            session.successCount++;
+            // 不是本会话最近发出的请求（上一个会话或已被覆盖的序列号）或超过RTT上限的响应视为过期，不计入成功数
+            uint64_t sendUs;
+            if (!session.sendHistory.find(pingRsp->sequenceNumber, sendUs) || rxTimeUs < sendUs ||
+                rxTimeUs - sendUs > PING_RTT_MAX_US)
+            {
+                elog_w("PingResponseHandler", "Discard stale ping response from slave 0x%08X (seq=%d)", slaveId,
+                       pingRsp->sequenceNumber);
+                break;
+            }
+
+            if (session.targetId == slaveId)
+            {
+                session.successCount++;
+            }
+
+            SlaveRttStats &stats = session.slaveStats[slaveId];
+            stats.successCount++;
+            stats.rttUs.record(static_cast<uint32_t>(rxTimeUs - sendUs));
             break;
         }
     }
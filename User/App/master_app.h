@@ -12,6 +12,7 @@
 #define TDMA_EXTRA_DELAY_MS 100                          // TDMA额外延迟时间 (ms)
 #define TDMA_MIN_CYCLE_MS TDMA_EXTRA_DELAY_MS            // TDMA最小周期时间 (ms)
 #define SYNC_START_DELAY_US (TDMA_EXTRA_DELAY_MS * 1000) // 同步启动延迟时间 (us) - 500ms
+#define SYNC_TX_LATENCY_MAX_US 20000                     // 同步帧发送延迟补偿上限 (us)，超过视为异常样本
 
 // ========== RETRY AND TIMEOUT CONFIGURATIONS ==========
 #define DEFAULT_MAX_RETRIES 3            // 默认最大重试次数
@@ -34,11 +35,35 @@
 #define UWB_FAILURE_RESET_INTERVAL_MS 30000 // UWB失败重置间隔 (ms)
 #define UWB_HEALTH_CHECK_INTERVAL_MS 60000  // UWB健康检查间隔 (ms)
 
+// ========== PING STATISTICS ==========
+#define PING_RTT_MAX_US 2000000 // RTT有效上限 (us)，超过视为过期/异常响应
+#define PING_SEND_HISTORY 16    // 每个Ping会话记录发送时刻的最近请求数
+
+// ========== UWB BENCHMARK ==========
+#define UWB_BENCH_SEQ_FLAG 0x8000       // 吞吐测试Ping序号标志位，低15位为帧序号
+#define UWB_BENCH_MAX_COUNT 0x7FFF      // 单次吞吐测试最大帧数
+#define UWB_BENCH_SEND_HISTORY 64       // 记录发送时刻的最近帧数，更早帧的响应只计入收包不计RTT
+#define UWB_BENCH_DRAIN_MS 500          // 全部发出后等待剩余响应的时间 (ms)
+#define UWB_BENCH_STALL_TIMEOUT_MS 5000 // 无发送也无响应超过该时间视为停滞并终止 (ms)
+#define UWB_BENCH_STATUS_COMPLETE 0     // 测试正常结束
+#define UWB_BENCH_STATUS_REJECTED 1     // 请求无效或已有测试在运行
+#define UWB_BENCH_STATUS_ABORTED 2      // 被后端停止或中途停滞
+
+// ========== UWB PHY PROFILE ADAPTATION ==========
+#define PHY_ADAPT_INTERVAL_MS 5000         // 自适应评估周期 (ms)
+#define PHY_ADAPT_MIN_SAMPLES 10           // 单个从机每周期至少发出的Ping请求数，不足时不参与评估
+#define PHY_ADAPT_DEGRADE_LOSS_PERMILLE 50 // 最差从机丢包率超过该值时切换到更稳健的档位 (‰)
+#define PHY_ADAPT_UPGRADE_LOSS_PERMILLE 5  // 所有从机丢包率低于该值时视为链路良好 (‰)
+#define PHY_ADAPT_UPGRADE_WINDOWS 6        // 连续多少个良好周期后切换到更快的档位
+#define PHY_ADAPT_REVERT_WINDOWS 2         // 自动切换后连续多少个周期发出Ping却收不到任何响应时退回原档位
+
 // ========== TASK AND PROCESSING CONFIGURATIONS ==========
 #define MAX_BACKEND_PROCESS_TIME_MS 5000  // 后端处理最大时间 (ms)
 #define MAX_BACKEND_PROCESS_ITERATIONS 10 // 后端处理最大迭代次数
 #define TASK_DELAY_MS 1                   // 任务延迟时间 (ms)
 #define MAIN_LOOP_DELAY_MS 500            // 主循环延迟时间 (ms)
+#define MASTER_INBOX_SIZE 32              // MainTask事件队列深度 (必须为2的幂)
+#define MASTER_INBOX_DRAIN_MAX 16         // MainTask每轮最多处理的事件数
 
 // ========== BUFFER AND QUEUE SIZES ==========
 #define UDP_DATA_TRANSFER_STACK_SIZE 1024     // UDP数据传输栈大小
@@ -4,14 +4,64 @@
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
-#include <functional>
-#include <queue>
 #include <vector>
 
 #include "cx_uci.hpp"
 #include "elog.h"
+#include "uci_buffer.hpp"
 
 #define UWB_GENERAL_TIMEOUT_MS 2000
+#define UWB_RX_RING_SIZE (2 * UCI_MAX_PACKET_SIZE)    // SPI原始数据缓冲区
+#define UWB_RX_DATA_QUEUE_SIZE 4096    // 透传数据帧队列
+#define UWB_CMD_QUEUE_DEPTH 4    // 异步命令队列深度
+#define UWB_TX_DONE_HISTORY 4    // 记录INT时刻的最近发送完成通知数
+
+/**
+ * @brief 异步命令完成回调
+ * @param ctx 提交时传入的上下文
+ * @param ok 响应状态为STATUS_OK时为true，超时或失败为false
+ * @param rsp 匹配的响应包，超时时为nullptr
+ */
+typedef void (*UciCmdCallback)(void* ctx, bool ok, const UciCtrlPacket* rsp);
+
+/* 异步命令统计 */
+struct UciCmdStats {
+    uint32_t submitted;
+    uint32_t completed;
+    uint32_t failed;
+    uint32_t timeouts;
+    uint32_t mismatched;
+};
+
+/* 配置影子表统计 */
+struct UciShadowStats {
+    uint32_t read_hits;      // 读取直接由影子表返回
+    uint32_t read_misses;    // 影子值未同步，向芯片查询
+    uint32_t write_skips;    // 写入值与芯片当前值相同，跳过命令
+    uint32_t resyncs;        // 复位后整表回读次数
+};
+
+/* 发送完成后回到接收的统计 */
+struct UciRecvStats {
+    uint32_t tx_done;         // 发送完成通知次数
+    uint32_t auto_rearms;     // 芯片自动回到接收（无需主机命令）
+    uint32_t host_rearms;     // 主机补发接收命令
+    uint32_t rearm_failed;    // 补发接收命令失败
+    uint32_t rearm_max_ms;    // 发送完成到补发命令响应的最长时间
+};
+
+/* 一套完整的PHY参数，取值含义见 cx_uci_def.hpp */
+struct CX310PhyConfig {
+    uint8_t channel;
+    uint8_t phr_mode;
+    uint8_t sfd_id;
+    uint8_t prf_mode;
+    uint8_t preamble_length;
+    uint8_t preamble_index;
+    uint8_t psdu_data_rate;
+    uint32_t recv_delay_us;
+    uint8_t tx_power;
+};
 
 template <class Interface>
 class CX310 {
@@ -23,6 +73,18 @@ class CX310 {
 
    private:
     constexpr static const char* TAG = "CX310";
+    // 上电默认PHY参数
+    constexpr static CX310PhyConfig DEFAULT_PHY_CONFIG = {
+        PARAM_CHANNEL_NUMBER_5,        // channel 5
+        PARAM_PHYDATARATE_DRHM_HR,     // PHR mode 4
+        2,                             // SFD ID 2
+        PARAM_PRF_NOMINAL_64_M,        // PRF mode 3
+        PARAM_PREAMBLE_LEN_BPRF_64,    // preamble length 1
+        9,                             // preamble index 9
+        PARAM_PSDU_DATA_RATE_7_8,      // PSDU data rate 4
+        1000,                          // recv delay 1000us
+        3,                             // TX power 3
+    };
     enum UwbsSTA : uint8_t { BOOT = 0, READY, ACTIVE, ERROR };
 
     Interface interface;
@@ -33,14 +95,38 @@ class CX310 {
     UciCMD uci_cmd;
     UciNTF uci_ntf;
 
-    std::vector<uint8_t> rx_raw_buffer_vec;
-    std::queue<uint8_t, std::deque<uint8_t>> rx_data_queue;
-    std::queue<uint8_t, std::deque<uint8_t>> transparent_data;
-    uint8_t _data;
-
-    std::function<bool(const UciCtrlPacket&)> check_rsp = nullptr;
-    std::function<bool()> cmd_packer = nullptr;
-    bool uwb_tx_done;
+    // SPI读出的原始UCI字节流，DMA直接写入，按包头整包解析
+    UciByteRing<UWB_RX_RING_SIZE> rx_ring;
+    // 重组后的透传数据，每个DATA_RX通知一帧，以片段形式交给上层，每帧附带其通知的INT时刻
+    UciFrameQueue<UWB_RX_DATA_QUEUE_SIZE> transparent_data;
+    // 最近一次从SPI读入的数据包对应的INT时刻，随通知一起锁存
+    uint64_t rx_pkt_int_us = 0;
+    // 最近几次发送完成通知的INT时刻，按recv_stats.tx_done计数索引
+    uint64_t tx_done_int_us[UWB_TX_DONE_HISTORY] = {};
+
+    // 未开启自动接收时，发送完成后由update()补发接收命令
+    bool rx_rearm_pending = false;
+    uint32_t tx_done_tick = 0;
+    UciRecvStats recv_stats = {};
+
+    // 异步命令队列：主机侧排队，芯片侧一次只有一条命令等待响应（UCI要求）
+    struct UciPendingCmd {
+        uint8_t gid;
+        uint8_t oid;
+        UciCmdCallback cb;
+        void* ctx;
+        std::vector<uint8_t> packet;    // 打包好的完整命令，容量复用不重复分配
+    };
+    UciPendingCmd cmd_queue[UWB_CMD_QUEUE_DEPTH];
+    uint8_t cmd_head = 0;
+    uint8_t cmd_count = 0;
+    bool cmd_inflight = false;
+    uint32_t cmd_sent_tick = 0;
+    UciCmdStats cmd_stats = {};
+
+    // 芯片应用配置的影子副本，复位后失效并重新回读
+    UciConfigShadow config_shadow;
+    UciShadowStats shadow_stats = {};
 
     /**
      * @brief 初始化
@@ -54,19 +140,22 @@ class CX310 {
      */
     bool reset(uint16_t timeout_ms = UWB_GENERAL_TIMEOUT_MS) {
         uwbs_sta = BOOT;
+        config_shadow.invalidate();
+        rx_rearm_pending = false;
         uci_cmd.core_device_reset();
-        check_rsp = [this](const UciCtrlPacket& rsp) {
+        auto check_rsp = [this](const UciCtrlPacket& rsp) {
             return uci_cmd.check_core_device_reset_rsp(rsp);
         };
 
-        cmd_packer = [this]() { return uci_cmd.core_device_reset(); };
+        auto cmd_packer = [this]() { return uci_cmd.core_device_reset(); };
 
-        if (__send_packet()) {
+        if (__send_packet(cmd_packer, check_rsp)) {
             uint32_t start_tick = interface.get_system_1ms_ticks();
             while (interface.get_system_1ms_ticks() - start_tick < timeout_ms) {
                 update();
                 if (uwbs_sta == READY) {
                     elog_v(TAG, "software reset successfully");
+                    resync_config();
                     return true;
                 }
             }
@@ -82,6 +171,7 @@ class CX310 {
             update();
             if (uwbs_sta == READY) {
                 elog_i(TAG, "hardware reset successfully");
+                resync_config();
                 return true;
             }
         }
@@ -90,17 +180,7 @@ class CX310 {
     }
 
     bool set_channel(uint8_t channel) {
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this, &channel]() {
-            return uci_cmd.core_set_config(PARAM_CHANNEL_NUMBER_ID, 1,
-                                           &channel);
-        };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_set_config_rsp(rsp);
-        };
-        if (__send_packet()) {
+        if (__set_config(PARAM_CHANNEL_NUMBER_ID, 1, &channel)) {
             elog_v(TAG, "set channel %d", channel);
             return true;
         }
@@ -109,43 +189,16 @@ class CX310 {
     }
 
     bool get_channel(uint8_t& channel) {
-        uint8_t param_id;
-        uint8_t val_len;
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this]() {
-            return uci_cmd.core_get_config(PARAM_CHANNEL_NUMBER_ID);
-        };
-        check_rsp = [this, &param_id, &val_len,
-                     &channel](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_get_config_rsp(rsp, &param_id, &val_len,
-                                                     &channel);
-        };
-        if (__send_packet()) {
-            if (param_id != PARAM_CHANNEL_NUMBER_ID) {
-                elog_e(TAG, "get config id %d", param_id);
-                return false;
-            } else {
-                elog_v(TAG, "get channel %d", channel);
-                return true;
-            }
+        if (__get_config(PARAM_CHANNEL_NUMBER_ID, 1, &channel)) {
+            elog_v(TAG, "get channel %d", channel);
+            return true;
         }
         elog_e(TAG, "get channel fail");
         return false;
     }
 
     bool set_prf_mode(uint8_t prf_mode) {
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this, &prf_mode]() {
-            return uci_cmd.core_set_config(PARAM_PRF_MODE_ID, 1, &prf_mode);
-        };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_set_config_rsp(rsp);
-        };
-        if (__send_packet()) {
+        if (__set_config(PARAM_PRF_MODE_ID, 1, &prf_mode)) {
             elog_v(TAG, "set prf mode %d", prf_mode);
             return true;
         }
@@ -154,44 +207,16 @@ class CX310 {
     }
 
     bool get_prf_mode(uint8_t& prf_mode) {
-        uint8_t param_id;
-        uint8_t val_len;
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this]() {
-            return uci_cmd.core_get_config(PARAM_PRF_MODE_ID);
-        };
-        check_rsp = [this, &param_id, &val_len,
-                     &prf_mode](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_get_config_rsp(rsp, &param_id, &val_len,
-                                                     &prf_mode);
-        };
-        if (__send_packet()) {
-            if (param_id != PARAM_PRF_MODE_ID) {
-                elog_e(TAG, "get config id %d", param_id);
-                return false;
-            } else {
-                elog_v(TAG, "get prf mode %d", prf_mode);
-                return true;
-            }
+        if (__get_config(PARAM_PRF_MODE_ID, 1, &prf_mode)) {
+            elog_v(TAG, "get prf mode %d", prf_mode);
+            return true;
         }
         elog_e(TAG, "get prf mode fail");
         return false;
     }
 
     bool set_preamble_length(uint8_t preamble_length) {
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this, &preamble_length]() {
-            return uci_cmd.core_set_config(PARAM_PREAMBLE_LENGTH_ID, 1,
-                                           &preamble_length);
-        };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_set_config_rsp(rsp);
-        };
-        if (__send_packet()) {
+        if (__set_config(PARAM_PREAMBLE_LENGTH_ID, 1, &preamble_length)) {
             elog_v(TAG, "set preamble length %d", preamble_length);
             return true;
         }
@@ -200,44 +225,16 @@ class CX310 {
     }
 
     bool get_preamble_length(uint8_t& preamble_length) {
-        uint8_t param_id;
-        uint8_t val_len;
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this]() {
-            return uci_cmd.core_get_config(PARAM_PREAMBLE_LENGTH_ID);
-        };
-        check_rsp = [this, &param_id, &val_len,
-                     &preamble_length](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_get_config_rsp(rsp, &param_id, &val_len,
-                                                     &preamble_length);
-        };
-        if (__send_packet()) {
-            if (param_id != PARAM_PREAMBLE_LENGTH_ID) {
-                elog_e(TAG, "get config id %d", param_id);
-                return false;
-            } else {
-                elog_v(TAG, "get preamble length %d", preamble_length);
-                return true;
-            }
+        if (__get_config(PARAM_PREAMBLE_LENGTH_ID, 1, &preamble_length)) {
+            elog_v(TAG, "get preamble length %d", preamble_length);
+            return true;
         }
         elog_e(TAG, "get preamble length fail");
         return false;
     }
 
     bool set_preamble_index(uint8_t preamble_index) {
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this, &preamble_index]() {
-            return uci_cmd.core_set_config(PARAM_PREAMBLE_CODE_INDEX_ID, 1,
-                                           &preamble_index);
-        };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_set_config_rsp(rsp);
-        };
-        if (__send_packet()) {
+        if (__set_config(PARAM_PREAMBLE_CODE_INDEX_ID, 1, &preamble_index)) {
             elog_v(TAG, "set preamble index %d", preamble_index);
             return true;
         }
@@ -246,44 +243,16 @@ class CX310 {
     }
 
     bool get_preamble_index(uint8_t& preamble_index) {
-        uint8_t param_id;
-        uint8_t val_len;
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this]() {
-            return uci_cmd.core_get_config(PARAM_PREAMBLE_CODE_INDEX_ID);
-        };
-        check_rsp = [this, &param_id, &val_len,
-                     &preamble_index](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_get_config_rsp(rsp, &param_id, &val_len,
-                                                     &preamble_index);
-        };
-        if (__send_packet()) {
-            if (param_id != PARAM_PREAMBLE_CODE_INDEX_ID) {
-                elog_e(TAG, "get config id %d", param_id);
-                return false;
-            } else {
-                elog_v(TAG, "get preamble index %d", preamble_index);
-                return true;
-            }
+        if (__get_config(PARAM_PREAMBLE_CODE_INDEX_ID, 1, &preamble_index)) {
+            elog_v(TAG, "get preamble index %d", preamble_index);
+            return true;
         }
         elog_e(TAG, "get preamble index fail");
         return false;
     }
 
     bool set_psdu_data_rate(uint8_t psdu_data_rate) {
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this, &psdu_data_rate]() {
-            return uci_cmd.core_set_config(PARAM_PSDU_DATA_RATE_ID, 1,
-                                           &psdu_data_rate);
-        };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_set_config_rsp(rsp);
-        };
-        if (__send_packet()) {
+        if (__set_config(PARAM_PSDU_DATA_RATE_ID, 1, &psdu_data_rate)) {
             elog_v(TAG, "set psdu data rate %d", psdu_data_rate);
             return true;
         }
@@ -292,86 +261,34 @@ class CX310 {
     }
 
     bool get_psdu_data_rate(uint8_t& psdu_data_rate) {
-        uint8_t param_id;
-        uint8_t val_len;
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this]() {
-            return uci_cmd.core_get_config(PARAM_PSDU_DATA_RATE_ID);
-        };
-        check_rsp = [this, &param_id, &val_len,
-                     &psdu_data_rate](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_get_config_rsp(rsp, &param_id, &val_len,
-                                                     &psdu_data_rate);
-        };
-        if (__send_packet()) {
-            if (param_id != PARAM_PSDU_DATA_RATE_ID) {
-                elog_e(TAG, "get config id %d", param_id);
-                return false;
-            } else {
-                elog_v(TAG, "get psdu data rate %d", psdu_data_rate);
-                return true;
-            }
+        if (__get_config(PARAM_PSDU_DATA_RATE_ID, 1, &psdu_data_rate)) {
+            elog_v(TAG, "get psdu data rate %d", psdu_data_rate);
+            return true;
         }
         elog_e(TAG, "get psdu data rate fail");
         return false;
     }
 
     bool set_phr_mode(uint8_t phr_mode) {
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this, &phr_mode]() {
-            return uci_cmd.core_set_config(PARAM_PHR_MODE_ID, 1, &phr_mode);
-        };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_set_config_rsp(rsp);
-        };
-        if (__send_packet()) {
+        if (__set_config(PARAM_PHR_MODE_ID, 1, &phr_mode)) {
             elog_v(TAG, "set phr mode %d", phr_mode);
             return true;
         }
         elog_e(TAG, "set phr mode fail");
         return false;
     }
+
     bool get_phr_mode(uint8_t& phr_mode) {
-        uint8_t param_id;
-        uint8_t val_len;
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this]() {
-            return uci_cmd.core_get_config(PARAM_PHR_MODE_ID);
-        };
-        check_rsp = [this, &param_id, &val_len,
-                     &phr_mode](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_get_config_rsp(rsp, &param_id, &val_len,
-                                                     &phr_mode);
-        };
-        if (__send_packet()) {
-            if (param_id != PARAM_PHR_MODE_ID) {
-                elog_e(TAG, "get config id %d", param_id);
-                return false;
-            } else {
-                elog_v(TAG, "get phr mode %d", phr_mode);
-                return true;
-            }
+        if (__get_config(PARAM_PHR_MODE_ID, 1, &phr_mode)) {
+            elog_v(TAG, "get phr mode %d", phr_mode);
+            return true;
         }
         elog_e(TAG, "get phr mode fail");
         return false;
     }
+
     bool set_sfd_id(uint8_t sfd_id) {
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this, &sfd_id]() {
-            return uci_cmd.core_set_config(PARAM_SFD_ID_ID, 1, &sfd_id);
-        };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_set_config_rsp(rsp);
-        };
-        if (__send_packet()) {
+        if (__set_config(PARAM_SFD_ID_ID, 1, &sfd_id)) {
             elog_v(TAG, "set sfd id %d", sfd_id);
             return true;
         }
@@ -380,43 +297,16 @@ class CX310 {
     }
 
     bool get_sfd_id(uint8_t& sfd_id) {
-        uint8_t param_id;
-        uint8_t val_len;
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this]() {
-            return uci_cmd.core_get_config(PARAM_SFD_ID_ID);
-        };
-        check_rsp = [this, &param_id, &val_len,
-                     &sfd_id](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_get_config_rsp(rsp, &param_id, &val_len,
-                                                     &sfd_id);
-        };
-        if (__send_packet()) {
-            if (param_id != PARAM_SFD_ID_ID) {
-                elog_e(TAG, "get config id %d", param_id);
-                return false;
-            } else {
-                elog_v(TAG, "get sfd id %d", sfd_id);
-                return true;
-            }
+        if (__get_config(PARAM_SFD_ID_ID, 1, &sfd_id)) {
+            elog_v(TAG, "get sfd id %d", sfd_id);
+            return true;
         }
         elog_e(TAG, "get sfd id fail");
         return false;
     }
 
     bool set_tx_power(uint8_t tx_power) {
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this, &tx_power]() {
-            return uci_cmd.core_set_config(PARAM_TX_POWER_ID, 1, &tx_power);
-        };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_set_config_rsp(rsp);
-        };
-        if (__send_packet()) {
+        if (__set_config(PARAM_TX_POWER_ID, 1, &tx_power)) {
             elog_v(TAG, "set tx power %d", tx_power);
             return true;
         }
@@ -428,11 +318,11 @@ class CX310 {
         if (!__check_rdy()) {
             return false;
         }
-        cmd_packer = [this]() { return uci_cmd.cx_set_hprf(); };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
+        auto cmd_packer = [this]() { return uci_cmd.cx_set_hprf(); };
+        auto check_rsp = [this](const UciCtrlPacket& rsp) {
             return uci_cmd.check_cx_set_hprf_rsp(rsp);
         };
-        if (__send_packet()) {
+        if (__send_packet(cmd_packer, check_rsp)) {
             elog_v(TAG, "set hprf");
             return true;
         }
@@ -441,153 +331,257 @@ class CX310 {
     }
 
     bool set_auto_recv_en(uint8_t en) {
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this, &en]() {
-            return uci_cmd.core_set_config(PARAM_CX_AUTO_RX_EN_ID, 1, &en);
-        };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_set_config_rsp(rsp);
-        };
-        if (__send_packet()) {
-            elog_i(TAG, " set auto recv %d", en);
+        if (__set_config(PARAM_CX_AUTO_RX_EN_ID, 1, &en)) {
+            elog_v(TAG, "set auto recv %d", en);
             return true;
         }
-        elog_e(TAG, " set auto recv fail");
+        elog_e(TAG, "set auto recv fail");
         return false;
     }
 
     bool get_auto_recv_en(uint8_t& en) {
-        uint8_t param_id;
-        uint8_t val_len;
-        if (!__check_rdy()) {
-            return false;
+        if (__get_config(PARAM_CX_AUTO_RX_EN_ID, 1, &en)) {
+            elog_v(TAG, "get auto recv %d", en);
+            return true;
         }
-        cmd_packer = [this]() {
-            return uci_cmd.core_get_config(PARAM_CX_AUTO_RX_EN_ID);
-        };
-        check_rsp = [this, &param_id, &val_len, &en](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_get_config_rsp(rsp, &param_id, &val_len,
-                                                     &en);
-        };
-        if (__send_packet()) {
-            if (param_id != PARAM_CX_AUTO_RX_EN_ID) {
-                elog_e(TAG, " get config id %d", param_id);
-                return false;
-            }
+        elog_e(TAG, "get auto recv fail");
+        return false;
+    }
+
+    /**
+     * @brief 开启自动接收：每次发送完成后芯片经过delay_us自行回到接收
+     * 开关、延时、超时合并为一条SET_CONFIG命令下发
+     * @param delay_us 发送结束到接收使能的延时
+     * @param timeout_us 接收超时，0表示一直接收
+     * @return 设置成功返回true
+     */
+    bool set_auto_recv(uint32_t delay_us, uint32_t timeout_us) {
+        UciConfigBatch batch;
+        batch.add_u8(PARAM_CX_AUTO_RX_EN_ID, 1);
+        batch.add_u32(PARAM_CX_RX_EN_DELAY_ID, delay_us);
+        batch.add_u32(PARAM_CX_RX_TIMEOUT_ID, timeout_us);
+        if (apply_config(batch)) {
+            elog_v(TAG, "set auto recv, delay %d us, timeout %d us", delay_us,
+                   timeout_us);
+            return true;
         }
-        elog_i(TAG, " get auto recv %d", en);
-        return true;
+        elog_e(TAG, "set auto recv fail");
+        return false;
     }
 
-    bool set_recv_delay(uint32_t delay_us) {
-        if (!__check_rdy()) {
-            return false;
+    /* 影子表中记录的自动接收状态，不访问芯片 */
+    bool is_auto_recv() const {
+        uint8_t en = 0;
+        return config_shadow.get(PARAM_CX_AUTO_RX_EN_ID, 1, &en) && en != 0;
+    }
+
+    /* 发送完成后回到接收的统计 */
+    const UciRecvStats& get_recv_stats() const { return recv_stats; }
+
+    /**
+     * @brief 第n次发送完成通知（与get_recv_stats().tx_done计数一致）的INT时刻
+     * @return 微秒时间戳，n不在最近UWB_TX_DONE_HISTORY次内或不支持时返回0
+     */
+    uint64_t get_tx_done_int_us(uint32_t n) const {
+        if (n == 0 || recv_stats.tx_done - n >= UWB_TX_DONE_HISTORY) {
+            return 0;
         }
-        cmd_packer = [this, &delay_us]() {
-            return uci_cmd.core_set_config(
-                PARAM_CX_RX_EN_DELAY_ID, 4,
-                reinterpret_cast<uint8_t*>(&delay_us));
-        };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_set_config_rsp(rsp);
-        };
-        if (__send_packet()) {
-            elog_i(TAG, " set recv delay %d us", delay_us);
+        return tx_done_int_us[n % UWB_TX_DONE_HISTORY];
+    }
+
+    bool set_recv_delay(uint32_t delay_us) {
+        if (__set_config(PARAM_CX_RX_EN_DELAY_ID, 4, reinterpret_cast<uint8_t*>(&delay_us))) {
+            elog_v(TAG, "set recv delay %d us", delay_us);
             return true;
         }
-        elog_e(TAG, " set recv delay fail");
+        elog_e(TAG, "set recv delay fail");
         return false;
     }
 
     bool get_recv_delay(uint32_t& delay_us) {
-        uint8_t param_id;
-        uint8_t val_len;
+        if (__get_config(PARAM_CX_RX_EN_DELAY_ID, 4, reinterpret_cast<uint8_t*>(&delay_us))) {
+            elog_v(TAG, "get recv delay %d us", delay_us);
+            return true;
+        }
+        elog_e(TAG, "get recv delay fail");
+        return false;
+    }
+
+    bool set_recv_timeout(uint32_t timeout_us) {
+        if (__set_config(PARAM_CX_RX_TIMEOUT_ID, 4, reinterpret_cast<uint8_t*>(&timeout_us))) {
+            elog_v(TAG, "set recv timeout %d us", timeout_us);
+            return true;
+        }
+        elog_e(TAG, "set recv timeout fail");
+        return false;
+    }
+
+    bool get_recv_timeout(uint32_t& timeout_us) {
+        if (__get_config(PARAM_CX_RX_TIMEOUT_ID, 4, reinterpret_cast<uint8_t*>(&timeout_us))) {
+            elog_v(TAG, "get recv timeout %d us", timeout_us);
+            return true;
+        }
+        elog_e(TAG, "get recv timeout fail");
+        return false;
+    }
+
+    bool set_nooploop() {
         if (!__check_rdy()) {
             return false;
         }
-        cmd_packer = [this]() {
-            return uci_cmd.core_get_config(PARAM_CX_RX_EN_DELAY_ID);
-        };
-        check_rsp = [this, &param_id, &val_len,
-                     &delay_us](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_get_config_rsp(
-                rsp, &param_id, &val_len,
-                reinterpret_cast<uint8_t*>(&delay_us));
+        auto cmd_packer = [this]() { return uci_cmd.cx_nooploop(); };
+        auto check_rsp = [this](const UciCtrlPacket& rsp) {
+            return uci_cmd.check_cx_nooploop_rsp(rsp);
         };
-        if (__send_packet()) {
-            if (param_id != PARAM_CX_RX_EN_DELAY_ID) {
-                elog_e(TAG, " get config id %d", param_id);
-                return false;
-            }
+        if (__send_packet(cmd_packer, check_rsp)) {
+            elog_v(TAG, "set nooploop");
+            return true;
         }
-        elog_i(TAG, " get recv delay %d us", delay_us);
-        return true;
+        elog_e(TAG, "set nooploop fail");
+        return false;
     }
 
-    bool set_recv_timeout(uint32_t timeout_us) {
+    bool get_config(uint8_t config_id, uint8_t* config_value, uint8_t length) {
+        return false;
+    }
+
+    /**
+     * @brief 批量下发配置参数，所有参数合并为一条SET_CONFIG命令
+     * 与影子表相同的参数不下发；固件拒绝多参数命令时退回逐条下发
+     * @return 全部参数设置成功返回true
+     */
+    bool apply_config(const UciConfigBatch& requested) {
         if (!__check_rdy()) {
             return false;
         }
-        cmd_packer = [this, &timeout_us]() {
-            return uci_cmd.core_set_config(
-                PARAM_CX_RX_TIMEOUT_ID, 4,
-                reinterpret_cast<uint8_t*>(&timeout_us));
+        UciConfigBatch batch;
+        uint8_t param_id;
+        uint8_t val_len;
+        const uint8_t* val;
+        for (uint8_t i = 0; requested.at(i, param_id, val_len, val); i++) {
+            if (config_shadow.matches(param_id, val_len, val)) {
+                shadow_stats.write_skips++;
+            } else {
+                batch.add(param_id, val_len, val);
+            }
+        }
+        if (batch.count() == 0) {
+            return true;
+        }
+        auto cmd_packer = [this, &batch]() {
+            return uci_cmd.core_set_config(batch);
         };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
+        auto check_rsp = [this](const UciCtrlPacket& rsp) {
             return uci_cmd.check_core_set_config_rsp(rsp);
         };
-        if (__send_packet()) {
-            elog_i(TAG, " set recv timeout %d us", timeout_us);
+        if (__send_packet(cmd_packer, check_rsp)) {
+            config_shadow.store(batch);
+            elog_v(TAG, "set config x%d", batch.count());
             return true;
         }
-        elog_e(TAG, " set recv timeout fail");
-        return false;
+        if (batch.count() == 1) {
+            elog_e(TAG, "set config fail");
+            return false;
+        }
+
+        elog_w(TAG, "batched set config rejected, falling back");
+        bool ok = true;
+        for (uint8_t i = 0; batch.at(i, param_id, val_len, val); i++) {
+            auto single_packer = [this, param_id, val_len, val]() {
+                return uci_cmd.core_set_config(param_id, val_len, val);
+            };
+            if (__send_packet(single_packer, check_rsp)) {
+                config_shadow.store(param_id, val_len, val);
+            } else {
+                elog_e(TAG, "set config 0x%02X fail", param_id);
+                ok = false;
+            }
+        }
+        return ok;
     }
 
-    bool get_recv_timeout(uint32_t& timeout_us) {
-        uint8_t param_id;
-        uint8_t val_len;
+    /**
+     * @brief 绕过影子表直接向芯片查询一个参数，并用结果刷新影子表
+     * 用于通信链路校验等必须与芯片实际往返的场合
+     */
+    bool query_config(uint8_t param_id, uint8_t val_len, uint8_t* val) {
+        uint8_t rsp_id = 0;
+        uint8_t rsp_len = 0;
+        uint8_t rsp_val[UINT8_MAX];    // 响应中的参数长度字段为1字节
         if (!__check_rdy()) {
             return false;
         }
-        cmd_packer = [this]() {
-            return uci_cmd.core_get_config(PARAM_CX_RX_TIMEOUT_ID);
+        auto cmd_packer = [this, param_id]() {
+            return uci_cmd.core_get_config(param_id);
         };
-        check_rsp = [this, &param_id, &val_len,
-                     &timeout_us](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_core_get_config_rsp(
-                rsp, &param_id, &val_len,
-                reinterpret_cast<uint8_t*>(&timeout_us));
+        auto check_rsp = [this, &rsp_id, &rsp_len,
+                          &rsp_val](const UciCtrlPacket& rsp) {
+            // 参数值长度以响应实际长度为准，防止越界拷贝
+            return (rsp.packet.size() >= 4) &&
+                   (rsp.packet.size() >= 4u + rsp.packet[3]) &&
+                   uci_cmd.check_core_get_config_rsp(rsp, &rsp_id, &rsp_len,
+                                                     rsp_val);
         };
-        if (__send_packet()) {
-            if (param_id != PARAM_CX_RX_TIMEOUT_ID) {
-                elog_e(TAG, " get config id %d", param_id);
-                return false;
-            }
+        if (!__send_packet(cmd_packer, check_rsp)) {
+            return false;
+        }
+        if ((rsp_id != param_id) || (rsp_len != val_len)) {
+            elog_e(TAG, "get config id %d len %d", rsp_id, rsp_len);
+            return false;
         }
-        elog_i(TAG, " get recv timeout %d us", timeout_us);
+        memcpy(val, rsp_val, val_len);
+        config_shadow.store(param_id, val_len, val);
         return true;
     }
 
-    bool set_nooploop() {
-        if (!__check_rdy()) {
-            return false;
-        }
-        cmd_packer = [this]() { return uci_cmd.cx_nooploop(); };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_cx_nooploop_rsp(rsp);
+    /**
+     * @brief 用一条多参数GET_CONFIG回读全部影子参数
+     * 固件不支持时影子表保持失效，各参数在首次读取时再单独查询
+     */
+    bool resync_config() {
+        uint8_t ids[UciConfigBatch::MAX_PARAMS];
+        uint8_t count = config_shadow.count();
+        for (uint8_t i = 0; i < count; i++) {
+            ids[i] = config_shadow.id_at(i);
+        }
+        config_shadow.invalidate();
+        auto cmd_packer = [this, &ids, count]() {
+            return uci_cmd.core_get_config(ids, count);
         };
-        if (__send_packet()) {
-            elog_v(TAG, "set nooploop");
+        auto check_rsp = [this](const UciCtrlPacket& rsp) {
+            return uci_cmd.check_core_get_config_rsp(rsp, config_shadow);
+        };
+        shadow_stats.resyncs++;
+        if (__send_packet(cmd_packer, check_rsp)) {
+            elog_v(TAG, "config shadow resynced");
             return true;
         }
-        elog_e(TAG, "set nooploop fail");
+        elog_w(TAG, "config shadow resync fail, reading on demand");
         return false;
     }
 
-    bool get_config(uint8_t config_id, uint8_t* config_value, uint8_t length) {
+    /* 配置影子表统计 */
+    const UciShadowStats& get_shadow_stats() const { return shadow_stats; }
+
+    /**
+     * @brief 一次性应用整套PHY参数
+     */
+    bool set_phy_config(const CX310PhyConfig& cfg) {
+        UciConfigBatch batch;
+        batch.add_u8(PARAM_CHANNEL_NUMBER_ID, cfg.channel);
+        batch.add_u8(PARAM_PHR_MODE_ID, cfg.phr_mode);
+        batch.add_u8(PARAM_SFD_ID_ID, cfg.sfd_id);
+        batch.add_u8(PARAM_PRF_MODE_ID, cfg.prf_mode);
+        batch.add_u8(PARAM_PREAMBLE_LENGTH_ID, cfg.preamble_length);
+        batch.add_u8(PARAM_PREAMBLE_CODE_INDEX_ID, cfg.preamble_index);
+        batch.add_u8(PARAM_PSDU_DATA_RATE_ID, cfg.psdu_data_rate);
+        batch.add_u32(PARAM_CX_RX_EN_DELAY_ID, cfg.recv_delay_us);
+        batch.add_u8(PARAM_TX_POWER_ID, cfg.tx_power);
+        if (apply_config(batch)) {
+            elog_v(TAG, "set phy config, channel %d", cfg.channel);
+            return true;
+        }
+        elog_e(TAG, "set phy config fail");
         return false;
     }
 
@@ -601,12 +595,12 @@ class CX310 {
         }
 
         UciCMD::UWBDeviceInfo dev_info;
-        cmd_packer = [this]() { return uci_cmd.core_get_device_info(); };
-        check_rsp = [this, &dev_info](const UciCtrlPacket& rsp) {
+        auto cmd_packer = [this]() { return uci_cmd.core_get_device_info(); };
+        auto check_rsp = [this, &dev_info](const UciCtrlPacket& rsp) {
             return uci_cmd.check_core_get_device_info_rsp(rsp, dev_info);
         };
 
-        if (__send_packet()) {
+        if (__send_packet(cmd_packer, check_rsp)) {
             elog_v(TAG,
                    "uci generic version = 0x%.4X, mac version = 0x%.4X, "
                    "phy version = 0x%.4X , uci test version = 0x%.4X",
@@ -626,99 +620,43 @@ class CX310 {
      * @return 发送成功返回true，失败返回false
      */
     bool data_transmit(const std::vector<uint8_t>& data) {
+        return data_transmit(data.data(), data.size());
+    }
+
+    /**
+     * @brief 数据透传（直接从调用者缓冲区打包，不经过中间vector）
+     * @param data 发送数据
+     * @param len 数据长度
+     * @return 发送成功返回true，失败返回false
+     */
+    bool data_transmit(const uint8_t* data, uint16_t len) {
         if (!__check_rdy()) {
             return false;
         }
 
-        if (data.size() == 0) {
+        if (len == 0) {
             return true;
         }
 
-        cmd_packer = [this, &data]() { return uci_cmd.cx_app_data_tx(data); };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_cx_app_data_tx_rsp(rsp);
-        };
-
-        if (__send_packet()) {
-            // elog_i(TAG, "data transmit");
-            return true;
-        }
-        elog_e(TAG, "data transmit fail");
-        return false;
-    }
-    bool data_transmit_tx_test(std::vector<uint8_t> data, uint16_t pack_size,
-                               uint16_t pack_num) {
-        if (!__check_rdy()) {
+        if (!uci_cmd.cx_app_data_tx(data, len)) {
+            elog_e(TAG, "data transmit fail: len %u", len);
             return false;
         }
 
-        data.reserve(pack_size);
-        for (uint16_t i = 0; i < pack_size; i++) {
-            data.push_back(i % 0xff);
-        }
-#define _CNT 2000
-        int delay_cnt = _CNT;
-        for (uint16_t i = 0; i < pack_num; i++) {
-            data[0] = i & 0xff;
-            data[1] = i >> 8;
-            data_transmit(data);
-
-            while (delay_cnt--) {
-                // __NOP();
-            }
-            delay_cnt = _CNT;
-            // interface.delay_ms(delay_cnt);
+        // 命令进入异步队列即返回，响应在update()中处理
+        bool ret = __cmd_submit(__on_data_tx_rsp, this, UWB_GENERAL_TIMEOUT_MS);
+        uci_cmd.reset_packer();
+        if (!ret) {
+            elog_e(TAG, "data transmit fail: command queue full");
         }
-        return true;
+        return ret;
     }
 
-    bool data_transmit_rx_test(std::vector<uint8_t> data, uint16_t pack_size,
-                               uint16_t pack_num) {
-        if (!__check_rdy()) {
-            return false;
-        }
-        uint16_t loss_pack = 0;
-        uint32_t time_ms = 0;
-        bool start_flag = false;
-        uint16_t recv_cnt = 0;
-        uint16_t pack_id = 0;
-        uint32_t start_tick = 0;
-        while (true) {
-            if (get_recv_data(data)) {
-                pack_id = data[0] | (data[1] << 8);
-                if (!start_flag) {
-                    if (pack_id == 0) {
-                        start_flag = true;
-                        recv_cnt = 1;
-                        start_tick = interface.get_system_1ms_ticks();
-                    }
-                } else {
-                    if (pack_id < recv_cnt) {
-                        elog_e(TAG, "pack id = %u, recv_cnt = %u", pack_id,
-                               recv_cnt);
-                        return false;
-                    }
-                    if (pack_id != recv_cnt) {
-                        loss_pack += pack_id - recv_cnt;
-                        recv_cnt = pack_id;
-                    }
-                    recv_cnt++;
-                    // elog_v("UWB: recv recv_cnt = %d", recv_cnt);
-                    if (recv_cnt == pack_num) {
-                        time_ms = interface.get_system_1ms_ticks() - start_tick;
-                        elog_v(TAG,
-                               "data transmit rx test: transmit pack = "
-                               "%u, loss pack = %u, "
-                               "time = %ums, transmit data = %uB",
-                               pack_num, loss_pack, time_ms,
-                               pack_num * pack_size);
-                        return true;
-                    }
-                }
-            }
-        }
-        return true;
-    }
+    /* 异步命令队列中未完成的命令数（含已发出等待响应的命令） */
+    uint8_t cmd_pending() const { return cmd_count; }
+
+    /* 异步命令统计 */
+    const UciCmdStats& get_cmd_stats() const { return cmd_stats; }
 
     /**
      * @brief 设置接收模式
@@ -729,12 +667,12 @@ class CX310 {
             return false;
         }
 
-        cmd_packer = [this]() { return uci_cmd.cx_app_data_rx(); };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
+        auto cmd_packer = [this]() { return uci_cmd.cx_app_data_rx(); };
+        auto check_rsp = [this](const UciCtrlPacket& rsp) {
             return uci_cmd.check_cx_app_data_rx_rsp(rsp);
         };
 
-        if (__send_packet()) {
+        if (__send_packet(cmd_packer, check_rsp)) {
             elog_i(TAG, "set recv mode");
             return true;
         }
@@ -748,19 +686,63 @@ class CX310 {
      * @return 获取成功返回true，失败返回false
      */
     bool get_recv_data(std::vector<uint8_t>& recv_data) {
+        UciSpan span;
+        if (!has_recv_data() || !transparent_data.front(span)) {
+            return false;
+        }
+        recv_data.assign(span.data, span.data + span.len);
+        transparent_data.pop();
+        return true;
+    }
+
+    /**
+     * @brief 是否有待取出的透传数据（会先处理芯片上送的数据）
+     * @return 有数据返回true
+     */
+    bool has_recv_data() {
         update();
         if (!__check_rdy()) {
             return false;
         }
-        if (transparent_data.empty()) {
+        return !transparent_data.empty();
+    }
+
+    /**
+     * @brief 获取队首透传数据帧，不拷贝
+     * @param span 指向驱动内部存储的数据片段，在recv_data_pop()或下一次update()前有效
+     * @param rx_int_us 非空时返回该帧接收通知的INT时刻（不支持时为0）
+     * @return 有数据返回true
+     */
+    bool recv_data_front(UciSpan& span, uint64_t* rx_int_us = nullptr) const {
+        return transparent_data.front(span, rx_int_us);
+    }
+
+    /* 丢弃队首透传数据帧 */
+    void recv_data_pop() { transparent_data.pop(); }
+
+    /* 因队列满被丢弃的透传数据帧数 */
+    uint32_t recv_data_dropped() const { return transparent_data.dropped(); }
+
+    /**
+     * @brief 取出一帧透传数据到调用者提供的缓冲区（不调用update）
+     * @param dst 目标缓冲区
+     * @param cap 缓冲区容量，超出部分丢弃
+     * @param len 实际取出的长度
+     * @param rx_int_us 非空时返回该帧接收通知的INT时刻（不支持时为0）
+     * @return 取到数据返回true，无数据返回false
+     */
+    bool get_recv_data(uint8_t* dst, uint16_t cap, uint16_t& len, uint64_t* rx_int_us = nullptr) {
+        UciSpan span;
+        len = 0;
+        if (!transparent_data.front(span, rx_int_us)) {
             return false;
         }
-        recv_data.clear();
-        recv_data.reserve(transparent_data.size());
-        while (transparent_data.empty() == false) {
-            recv_data.push_back(transparent_data.front());
-            transparent_data.pop();
+        if (span.len > cap) {
+            elog_w(TAG, "rx frame truncated: %u > %u", span.len, cap);
         }
+        len = span.len < cap ? span.len : cap;
+        memcpy(dst, span.data, len);
+        transparent_data.pop();
         return true;
     }
 
@@ -772,11 +754,11 @@ class CX310 {
         if (!__check_rdy()) {
             return false;
         }
-        cmd_packer = [this]() { return uci_cmd.cx_app_data_stop_rx(); };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
+        auto cmd_packer = [this]() { return uci_cmd.cx_app_data_stop_rx(); };
+        auto check_rsp = [this](const UciCtrlPacket& rsp) {
             return uci_cmd.check_cx_app_data_stop_rx_rsp(rsp);
         };
-        if (__send_packet()) {
+        if (__send_packet(cmd_packer, check_rsp)) {
             elog_v(TAG, "stop recv");
             return true;
         }
@@ -790,6 +772,8 @@ class CX310 {
      */
     void update() {
         __listening_ntf();
+        __cmd_poll();
+        __rx_rearm_poll();
         __uwbs_state_machine();
     }
 
@@ -797,26 +781,45 @@ class CX310 {
 
     bool init() {
         __init();
-        init_success &=
-            set_channel(PARAM_CHANNEL_NUMBER_5);    // channel 5 // channel 5
-        init_success &=
-            set_phr_mode(PARAM_PHYDATARATE_DRHM_HR);    // PHR mode 4
-        init_success &= set_sfd_id(2);                  // SFD ID 3 // SFD ID 3
-        init_success &= set_prf_mode(PARAM_PRF_NOMINAL_64_M);    // PRF mode 3
-        init_success &= set_preamble_length(
-            PARAM_PREAMBLE_LEN_BPRF_64);          // preamble length 1
-        init_success &= set_preamble_index(9);    // preamble index 9
-        init_success &=
-            set_psdu_data_rate(PARAM_PSDU_DATA_RATE_7_8);    // PSDU data rate 4
-
-        init_success &= set_recv_delay(1000);
-        init_success &= set_tx_power(3);    // TX power 5
-        // init_success &= set_auto_recv_en(1);
+        init_success &= set_phy_config(DEFAULT_PHY_CONFIG);
+        // 自动接收由上层按TDMA时序调用set_auto_recv()开启
         return 0;
     }
 
    private:
     void __delay_ms(uint32_t ms) { interface.delay_ms(ms); }
+
+    // 写单个参数，值与影子表相同时不下发
+    bool __set_config(uint8_t param_id, uint8_t val_len, const uint8_t* val) {
+        if (!__check_rdy()) {
+            return false;
+        }
+        if (config_shadow.matches(param_id, val_len, val)) {
+            shadow_stats.write_skips++;
+            return true;
+        }
+        auto cmd_packer = [this, param_id, val_len, val]() {
+            return uci_cmd.core_set_config(param_id, val_len, val);
+        };
+        auto check_rsp = [this](const UciCtrlPacket& rsp) {
+            return uci_cmd.check_core_set_config_rsp(rsp);
+        };
+        if (__send_packet(cmd_packer, check_rsp)) {
+            config_shadow.store(param_id, val_len, val);
+            return true;
+        }
+        return false;
+    }
+
+    // 读单个参数，优先返回影子值
+    bool __get_config(uint8_t param_id, uint8_t val_len, uint8_t* val) {
+        if (config_shadow.get(param_id, val_len, val)) {
+            shadow_stats.read_hits++;
+            return true;
+        }
+        shadow_stats.read_misses++;
+        return query_config(param_id, val_len, val);
+    }
     bool __check_rdy() {
         if (uwbs_sta == READY) {
             return true;
@@ -843,27 +846,58 @@ class CX310 {
         }
     }
 
-    void __load_recv_data() { interface.get_recv_data(rx_data_queue); }
+    void __load_recv_data() {
+        // SPI直接读入缓冲区尾部的连续空间；空间不足时先不读，数据留在芯片中
+        uint8_t* dst = rx_ring.write_span(UCI_MAX_PACKET_SIZE);
+        if (dst == nullptr) {
+            return;
+        }
+        uint16_t n = interface.get_recv_data(dst, UCI_MAX_PACKET_SIZE);
+        if (n != 0) {
+            rx_ring.commit(n);
+            rx_pkt_int_us = interface.get_recv_int_us();
+        }
+    }
+
+    /**
+     * @brief 包头驱动解析：先看4字节包头，负载收齐后整块拷贝
+     * @return 解析出一个完整消息（可能由多个分段组成）返回true，结果在recv_packet中
+     */
+    bool __parse_packet() {
+        while (rx_ring.size() >= UCI_CTRL_PKT_HDR_SIZE) {
+            const uint8_t* hdr = rx_ring.data();
+            if (!recv_packet.parse_header(hdr)) {
+                // 包头非法，丢弃一个字节重新同步
+                rx_ring.consume(1);
+                continue;
+            }
+
+            uint16_t total = UCI_CTRL_PKT_HDR_SIZE + recv_packet.payload_len();
+            if (rx_ring.size() < total) {
+                return false;    // 负载未收齐
+            }
+
+            bool done =
+                recv_packet.append_payload(hdr + UCI_CTRL_PKT_HDR_SIZE);
+            rx_ring.consume(total);
+            if (done) {
+                return true;
+            }
+        }
+        return false;
+    }
 
     bool __rsp_process(uint32_t timeout_ms) {
         uint32_t start_tick = interface.get_system_1ms_ticks();
         while (interface.get_system_1ms_ticks() - start_tick < timeout_ms) {
             __load_recv_data();
-            while (rx_data_queue.empty() == false) {
-                _data = rx_data_queue.front();
-                // elog_w(TAG, "recv data: %02x", _data);
-                rx_data_queue.pop();
-
-                if (recv_packet.flow_parse(_data)) {
-                    //  Log.r(recv_packet.packet.data(),
-                    //   recv_packet.packet.size());
-                    if (recv_packet.mt == MT_RSP) {
-                        // 接收到响应
-                        return true;
-                    } else if (recv_packet.mt == MT_NTF) {
-                        // 接收到通知
-                        __notify_process();
-                    }
+            while (__parse_packet()) {
+                if (recv_packet.mt == MT_RSP) {
+                    // 接收到响应
+                    return true;
+                } else if (recv_packet.mt == MT_NTF) {
+                    // 接收到通知
+                    __notify_process();
                 }
             }
         }
@@ -873,16 +907,153 @@ class CX310 {
 
     void __listening_ntf() {
         __load_recv_data();
-        while (rx_data_queue.empty() == false) {
-            _data = rx_data_queue.front();
-            rx_data_queue.pop();
-            if (recv_packet.flow_parse(_data)) {
-                if (recv_packet.mt == MT_NTF) {
-                    __notify_process();
-                } else {
-                    elog_e(TAG, "unexpected rsp packet");
-                }
+        while (__parse_packet()) {
+            if (recv_packet.mt == MT_NTF) {
+                __notify_process();
+            } else if (recv_packet.mt == MT_RSP) {
+                __cmd_on_rsp(recv_packet);
+            } else {
+                elog_e(TAG, "unexpected packet mt=%u", recv_packet.mt);
+            }
+        }
+    }
+
+    /**
+     * @brief 提交uci_cmd.packet中已打包好的单包命令到异步队列
+     * @param wait_ms 队列满时等待已发出命令完成的最长时间
+     * @return 入队成功返回true
+     */
+    bool __cmd_submit(UciCmdCallback cb, void* ctx, uint32_t wait_ms) {
+        uint32_t start_tick = interface.get_system_1ms_ticks();
+        while (cmd_count >= UWB_CMD_QUEUE_DEPTH) {
+            if (interface.get_system_1ms_ticks() - start_tick >= wait_ms) {
+                return false;
+            }
+            __listening_ntf();
+            __cmd_poll();
+        }
+
+        UciPendingCmd& cmd =
+            cmd_queue[(cmd_head + cmd_count) % UWB_CMD_QUEUE_DEPTH];
+        cmd.gid = uci_cmd.packet[0] & 0x0F;
+        cmd.oid = uci_cmd.packet[1] & 0x3F;
+        cmd.cb = cb;
+        cmd.ctx = ctx;
+        cmd.packet.assign(uci_cmd.packet.begin(), uci_cmd.packet.end());
+        cmd_count++;
+        cmd_stats.submitted++;
+
+        // 芯片空闲时立即发出
+        __cmd_poll();
+        return true;
+    }
+
+    /* 检查在途命令超时，芯片空闲时发出队首命令 */
+    void __cmd_poll() {
+        if (cmd_inflight) {
+            if (interface.get_system_1ms_ticks() - cmd_sent_tick <
+                UWB_GENERAL_TIMEOUT_MS) {
+                return;
             }
+            elog_e(TAG, "cmd timeout: gid=0x%.2X oid=0x%.2X",
+                   cmd_queue[cmd_head].gid, cmd_queue[cmd_head].oid);
+            cmd_stats.timeouts++;
+            __cmd_complete(false, nullptr);
+        }
+
+        if (cmd_count > 0 && !cmd_inflight) {
+            cmd_inflight = true;
+            cmd_sent_tick = interface.get_system_1ms_ticks();
+            interface.send(cmd_queue[cmd_head].packet);
+        }
+    }
+
+    /* 按GID/OID匹配在途命令的响应 */
+    void __cmd_on_rsp(const UciCtrlPacket& rsp) {
+        if (!cmd_inflight) {
+            elog_e(TAG, "unexpected rsp packet");
+            return;
+        }
+        const UciPendingCmd& cmd = cmd_queue[cmd_head];
+        if (rsp.gid != cmd.gid || rsp.oid != cmd.oid) {
+            elog_e(TAG, "rsp mismatch: gid=0x%.2X oid=0x%.2X", rsp.gid,
+                   rsp.oid);
+            cmd_stats.mismatched++;
+            return;
+        }
+        bool ok = !rsp.packet.empty() && rsp.packet[0] == STATUS_OK;
+        __cmd_complete(ok, &rsp);
+        // 立即发出下一条，减少芯片空闲时间
+        __cmd_poll();
+    }
+
+    void __cmd_complete(bool ok, const UciCtrlPacket* rsp) {
+        UciPendingCmd& cmd = cmd_queue[cmd_head];
+        UciCmdCallback cb = cmd.cb;
+        void* ctx = cmd.ctx;
+
+        cmd_head = (cmd_head + 1) % UWB_CMD_QUEUE_DEPTH;
+        cmd_count--;
+        cmd_inflight = false;
+        cmd_stats.completed++;
+        if (!ok) {
+            cmd_stats.failed++;
+        }
+
+        if (cb != nullptr) {
+            cb(ctx, ok, rsp);
+        }
+    }
+
+    /* 同步命令发送前清空异步队列，避免同步等待吞掉异步命令的响应 */
+    void __cmd_flush() {
+        while (cmd_count > 0) {
+            __listening_ntf();
+            __cmd_poll();
+        }
+    }
+
+    static void __on_data_tx_rsp(void* ctx, bool ok, const UciCtrlPacket* rsp) {
+        (void)ctx;
+        if (!ok) {
+            elog_e(TAG, "data transmit fail: status 0x%.2X",
+                   (rsp != nullptr && !rsp->packet.empty()) ? rsp->packet[0]
+                                                            : 0xFF);
+        }
+    }
+
+    /**
+     * @brief 发送完成后补发接收命令（未开启自动接收时）
+     * 只在update()中调用：此时uci_cmd没有正在打包的同步命令，可以安全复用
+     */
+    void __rx_rearm_poll() {
+        if (!rx_rearm_pending || !__check_rdy()) {
+            return;
+        }
+        if (!uci_cmd.cx_app_data_rx()) {
+            return;
+        }
+        // 队列满时不等待，下次update()再试
+        bool ret = __cmd_submit(__on_rx_rearm_rsp, this, 0);
+        uci_cmd.reset_packer();
+        if (ret) {
+            rx_rearm_pending = false;
+        }
+    }
+
+    static void __on_rx_rearm_rsp(void* ctx, bool ok, const UciCtrlPacket* rsp) {
+        (void)rsp;
+        CX310* self = static_cast<CX310*>(ctx);
+        if (!ok) {
+            self->recv_stats.rearm_failed++;
+            elog_e(TAG, "rx rearm fail");
+            return;
+        }
+        self->recv_stats.host_rearms++;
+        uint32_t elapsed =
+            self->interface.get_system_1ms_ticks() - self->tx_done_tick;
+        if (elapsed > self->recv_stats.rearm_max_ms) {
+            self->recv_stats.rearm_max_ms = elapsed;
         }
     }
 
@@ -914,6 +1085,15 @@ class CX310 {
                         STATUS_OK) {
                         elog_e(TAG, "parse data tx ntf fail");
                     }
+                    recv_stats.tx_done++;
+                    tx_done_int_us[recv_stats.tx_done % UWB_TX_DONE_HISTORY] = rx_pkt_int_us;
+                    if (is_auto_recv()) {
+                        recv_stats.auto_rearms++;
+                    } else {
+                        // 不在通知处理中直接打包命令，可能正处于同步命令收发过程中
+                        tx_done_tick = interface.get_system_1ms_ticks();
+                        rx_rearm_pending = true;
+                    }
                     break;
                 }
                 case CX_APP_DATA_RX_NTF: {
@@ -925,9 +1105,10 @@ class CX310 {
                         elog_e(TAG, "rx payload size is too small");
                         break;
                     }
-                    for (auto it = recv_packet.packet.begin() + 2;
-                         it != recv_packet.packet.end(); it++) {
-                        transparent_data.push(*it);
+                    if (!transparent_data.push(
+                            recv_packet.packet.data() + 2,
+                            recv_packet.packet.size() - 2, rx_pkt_int_us)) {
+                        elog_w(TAG, "rx data queue full, frame dropped");
                     }
                     // elog_v("UWB: data receive, size=%u",
                     //               rx_payload.size() - 2);
@@ -991,10 +1172,16 @@ class CX310 {
         // __delay_ms(500);
         // reset(3000);
     }
-    bool __send_packet() {
-        if ((cmd_packer == nullptr) || (check_rsp == nullptr)) {
-            return false;
-        }
+    /**
+     * @brief 发送一条（可能分段的）同步命令并等待响应
+     * cmd_packer/check_rsp 以模板参数传入，lambda 直接内联，不经过 std::function
+     * 的类型擦除，命令路径上不产生堆分配
+     * @param cmd_packer 组包，返回true表示负载已全部组包
+     * @param check_rsp 校验响应
+     */
+    template <typename Packer, typename Checker>
+    bool __send_packet(Packer&& cmd_packer, Checker&& check_rsp) {
+        __cmd_flush();
         bool send_flag = true;
         bool pack_all_payload = false;
         bool ret = false;
@@ -1024,8 +1211,6 @@ class CX310 {
             }
         }
         uci_cmd.reset_packer();
-        cmd_packer = nullptr;
-        check_rsp = nullptr;
         return ret;
     }
 };
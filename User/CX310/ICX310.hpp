@@ -2,7 +2,6 @@
 #include <cstdint>
 #include <cstdio>
 #include <functional>
-#include <queue>
 #include <vector>
 
 class ICX310 {
@@ -39,11 +38,18 @@ class ICX310 {
     virtual bool send(std::vector<uint8_t>& tx_data) = 0;
 
     /**
-     * @brief 接收数据
-     * @param rx_data 接收数据
-     * @return 接收成功返回true，失败返回false
+     * @brief 接收一个UCI包（包头+负载）
+     * @param rx_data 接收缓冲区，由调用者提供的连续空间
+     * @param cap 缓冲区容量
+     * @return 接收到的字节数，无数据或失败返回0
      */
-    virtual bool get_recv_data(std::queue<uint8_t>& rx_data) = 0;
+    virtual uint16_t get_recv_data(uint8_t* rx_data, uint16_t cap) = 0;
+
+    /**
+     * @brief 最近一次get_recv_data()读出的数据包对应的INT中断时刻
+     * @return 微秒时间戳，不支持时返回0
+     */
+    virtual uint64_t get_recv_int_us() { return 0; }
 
     /* 获取系统1ms时间戳 */
     virtual uint32_t get_system_1ms_ticks() = 0;
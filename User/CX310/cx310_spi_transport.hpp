@@ -0,0 +1,217 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief CX310 SPI 端口抽象
+ * 由平台实现：STM32 上使用 HAL SPI DMA + EXTI（CX310_SlaveSpiAdapter），
+ * 主机端使用 host/fake_cx310_spi_port.hpp 中的模拟端口。
+ */
+class ICX310SpiPort {
+   public:
+    virtual ~ICX310SpiPort() = default;
+
+    /* 片选控制 */
+    virtual void nss_low() = 0;
+    virtual void nss_high() = 0;
+
+    /* RDY引脚是否有效（低电平表示从机已准备好接收） */
+    virtual bool rdy_active() = 0;
+
+    /**
+     * @brief 启动DMA发送，完成后平台在中断中调用 CX310SpiTransport::on_dma_done_isr
+     * @return 启动成功返回true
+     */
+    virtual bool start_tx(const uint8_t* tx, uint16_t len) = 0;
+
+    /**
+     * @brief 启动DMA全双工传输，tx为nullptr时发送填充字节
+     * @return 启动成功返回true
+     */
+    virtual bool start_txrx(const uint8_t* tx, uint8_t* rx, uint16_t len) = 0;
+
+    /* 中止进行中的DMA传输（仅在任务上下文调用） */
+    virtual void abort() = 0;
+
+    /* 等待事件（RDY有效/DMA完成），超时返回false */
+    virtual bool wait_event(uint32_t timeout_ms) = 0;
+
+    /* 唤醒wait_event，可在中断中调用 */
+    virtual void signal_event_isr() = 0;
+
+    /* 获取系统1ms时间戳 */
+    virtual uint32_t now_ms() = 0;
+};
+
+/**
+ * @brief CX310 SPI 非阻塞传输状态机
+ * 任务上下文发起传输后在信号量上睡眠，RDY下降沿和DMA完成均由中断唤醒，
+ * 整个传输过程不关中断、不忙等，以太网和定时器中断不受影响。
+ *
+ *   send:    IDLE -> WAIT_RDY -> TX_BUSY -> IDLE
+ *   receive: IDLE -> RX_HEADER -> RX_BODY -> IDLE
+ *   任一步骤超时或DMA出错时中止传输、拉高NSS并回到IDLE
+ */
+class CX310SpiTransport {
+   public:
+    enum State : uint8_t { IDLE, WAIT_RDY, TX_BUSY, RX_HEADER, RX_BODY };
+
+    static constexpr uint16_t HEADER_LEN = 4;         // UCI包头长度
+    static constexpr uint32_t RDY_TIMEOUT_MS = 50;    // 等待从机就绪超时
+    static constexpr uint32_t DMA_TIMEOUT_MS = 50;    // 单次DMA传输超时
+
+    struct Stats {
+        uint32_t tx_frames;
+        uint32_t rx_frames;
+        uint32_t rdy_timeouts;
+        uint32_t dma_timeouts;
+        uint32_t dma_errors;
+        uint32_t rx_oversize;
+    };
+
+    explicit CX310SpiTransport(ICX310SpiPort& port) : port(port) {}
+
+    /**
+     * @brief 发送一个UCI包：拉低NSS，等待RDY有效，DMA发送，拉高NSS
+     * @return 发送成功返回true
+     */
+    bool send(const uint8_t* data, uint16_t len) {
+        if (state != IDLE || len == 0) {
+            return false;
+        }
+
+        state = WAIT_RDY;
+        port.nss_low();
+
+        // 先查电平再等边沿：RDY可能在拉低NSS前就已经有效
+        uint32_t start = port.now_ms();
+        while (!port.rdy_active()) {
+            uint32_t elapsed = port.now_ms() - start;
+            if (elapsed >= RDY_TIMEOUT_MS ||
+                !port.wait_event(RDY_TIMEOUT_MS - elapsed)) {
+                if (port.rdy_active()) {
+                    break;
+                }
+                stats.rdy_timeouts++;
+                return __finish(false);
+            }
+        }
+
+        state = TX_BUSY;
+        if (!__run_dma(data, nullptr, len, true)) {
+            return __finish(false);
+        }
+        stats.tx_frames++;
+        return __finish(true);
+    }
+
+    /**
+     * @brief 读取一个UCI包：先读4字节包头，再按包头中的长度读取负载
+     * @param rx 接收缓冲区
+     * @param cap 缓冲区容量
+     * @return 读取到的总长度（含包头），失败返回0
+     */
+    uint16_t receive(uint8_t* rx, uint16_t cap) {
+        if (state != IDLE || cap < HEADER_LEN) {
+            return 0;
+        }
+
+        state = RX_HEADER;
+        port.nss_low();
+        if (!__run_dma(nullptr, rx, HEADER_LEN, false)) {
+            __finish(false);
+            return 0;
+        }
+
+        uint16_t payload_len = (((uint16_t)rx[2]) << 8) | rx[3];
+        if (payload_len > cap - HEADER_LEN) {
+            stats.rx_oversize++;
+            __finish(false);
+            return 0;
+        }
+
+        if (payload_len > 0) {
+            state = RX_BODY;
+            if (!__run_dma(nullptr, rx + HEADER_LEN, payload_len, false)) {
+                __finish(false);
+                return 0;
+            }
+        }
+
+        stats.rx_frames++;
+        __finish(true);
+        return HEADER_LEN + payload_len;
+    }
+
+    /* RDY下降沿中断 */
+    void on_rdy_isr() {
+        if (state == WAIT_RDY) {
+            port.signal_event_isr();
+        }
+    }
+
+    /* DMA传输完成中断 */
+    void on_dma_done_isr() {
+        if (state == TX_BUSY || state == RX_HEADER || state == RX_BODY) {
+            dma_done = true;
+            port.signal_event_isr();
+        }
+    }
+
+    /* DMA/SPI错误中断 */
+    void on_dma_error_isr() {
+        if (state == TX_BUSY || state == RX_HEADER || state == RX_BODY) {
+            dma_error = true;
+            dma_done = true;
+            port.signal_event_isr();
+        }
+    }
+
+    State get_state() const { return state; }
+    const Stats& get_stats() const { return stats; }
+
+   private:
+    ICX310SpiPort& port;
+    volatile State state = IDLE;
+    volatile bool dma_done = false;
+    volatile bool dma_error = false;
+    Stats stats = {};
+
+    bool __run_dma(const uint8_t* tx, uint8_t* rx, uint16_t len, bool tx_only) {
+        dma_done = false;
+        dma_error = false;
+
+        bool started =
+            tx_only ? port.start_tx(tx, len) : port.start_txrx(tx, rx, len);
+        if (!started) {
+            stats.dma_errors++;
+            return false;
+        }
+
+        // 被之前遗留的事件唤醒时继续等待，直到完成标志置位或超时
+        uint32_t start = port.now_ms();
+        while (!dma_done) {
+            uint32_t elapsed = port.now_ms() - start;
+            if (elapsed >= DMA_TIMEOUT_MS ||
+                !port.wait_event(DMA_TIMEOUT_MS - elapsed)) {
+                if (dma_done) {
+                    break;
+                }
+                port.abort();
+                stats.dma_timeouts++;
+                return false;
+            }
+        }
+
+        if (dma_error) {
+            stats.dma_errors++;
+            return false;
+        }
+        return true;
+    }
+
+    bool __finish(bool ok) {
+        port.nss_high();
+        state = IDLE;
+        return ok;
+    }
+};
@@ -28,22 +28,12 @@ class UciCtrlPacket : public UciCtrlPcketBase {
     bool sending = false;    // 发送标志位
 
    private:
-    enum ParserSta : uint8_t {
-        PARSE_START = 0,
-        MT_PBF_GID_BYTE,
-        OID_BYTE,
-        RFU_BYTE,
-        PAYLOAD_LEN_BYTE,
-        PAYLOAD_BYTES,
-    };
     uint8_t pbf;                        // Packet Boundary Flag
     uint16_t current_packet_len = 0;    // uci数据包长度
     uint16_t payload_offset = 0;
     uint16_t currunt_payload_len = 0;
     bool is_last_packet = true;
-    ParserSta parser_sta = PARSE_START;
-    uint16_t pkt_recv_len = 0;
-    bool recv_packet = false;
+    bool segment_pending = false;    // 正在接收分段消息的后续分段
 
    public:
     void reset() {
@@ -52,9 +42,7 @@ class UciCtrlPacket : public UciCtrlPcketBase {
         payload_offset = 0;
         currunt_payload_len = 0;
         is_last_packet = true;
-        parser_sta = PARSE_START;
-        pkt_recv_len = 0;
-        recv_packet = false;
+        segment_pending = false;
     }
     bool build_packet(const std::vector<uint8_t>& total_payload) {
         size_t residual_len =
@@ -101,68 +89,50 @@ class UciCtrlPacket : public UciCtrlPcketBase {
         return is_last_packet;
     }
 
-    bool flow_parse(uint8_t& data) {
-        switch (parser_sta) {
-            case PARSE_START: {
-                recv_packet = false;
-                packet.clear();
-                parser_sta = MT_PBF_GID_BYTE;
-            }
-            case MT_PBF_GID_BYTE: {
-                mt = (data >> 5) & 0x07;
-                pbf = (data >> 4) & 0x01;
-                gid = data & 0x0F;
-                if ((mt != MT_CMD) && (mt != MT_RSP) && (mt != MT_NTF)) {
-                    parser_sta = PARSE_START;
-                    break;
-                }
-                if (pbf == PBF_COMPLETE) {
-                    is_last_packet = true;
-                } else {
-                    is_last_packet = false;
-                }
-                parser_sta = OID_BYTE;
-                break;
-            }
-            case OID_BYTE: {
-                oid = data & 0x3F;
-                currunt_payload_len = 0;
-                parser_sta = RFU_BYTE;
-                break;
-            }
-            case RFU_BYTE: {
-                currunt_payload_len |= ((uint16_t)data << 8);
-                parser_sta = PAYLOAD_LEN_BYTE;
-                break;
-            }
-            case PAYLOAD_LEN_BYTE: {
-                currunt_payload_len |= data;
-                pkt_recv_len = 0;
-                if (currunt_payload_len > 0) {
-                    parser_sta = PAYLOAD_BYTES;
-                } else {
-                    recv_packet = true;
-                    parser_sta = PARSE_START;
-                }
-                break;
-            }
-            case PAYLOAD_BYTES: {
-                packet.push_back(data);
-                pkt_recv_len++;
-                if (pkt_recv_len == currunt_payload_len) {
-                    recv_packet = true;
-                    if (is_last_packet) {
-                        // 是最后一个数据包，重置状态
-                        parser_sta = PARSE_START;
-                    } else {
-                        // 不是最后一个数据包，等待下一个数据包的开始
-                        parser_sta = MT_PBF_GID_BYTE;
-                    }
-                }
-                break;
-            }
+    /**
+     * @brief 解析4字节包头（包头驱动解析的第一步）
+     * 新消息的第一个分段会清空packet，后续分段的负载追加在其后。
+     * 重复解析同一个包头没有副作用，负载未收齐时可以下次再解析。
+     * @param hdr 包头
+     * @return 包头合法返回true，MT非法或负载长度超限返回false
+     */
+    bool parse_header(const uint8_t* hdr) {
+        uint8_t hdr_mt = (hdr[0] >> 5) & 0x07;
+        uint16_t len = ((uint16_t)hdr[2] << 8) | hdr[3];
+        if ((hdr_mt != MT_CMD) && (hdr_mt != MT_RSP) && (hdr_mt != MT_NTF)) {
+            return false;
+        }
+        if (len > MAX_PAYLOAD_LEN) {
+            return false;
         }
-        return (is_last_packet & recv_packet);
+
+        if (!segment_pending) {
+            packet.clear();
+        }
+        mt = hdr_mt;
+        pbf = (hdr[0] >> 4) & 0x01;
+        gid = hdr[0] & 0x0F;
+        oid = hdr[1] & 0x3F;
+        currunt_payload_len = len;
+        is_last_packet = (pbf == PBF_COMPLETE);
+        return true;
+    }
+
+    /* 当前包头中的负载长度 */
+    uint16_t payload_len() const { return currunt_payload_len; }
+
+    /**
+     * @brief 整块追加当前分段的负载（包头驱动解析的第二步）
+     * @return 消息的最后一个分段追加完成返回true
+     */
+    bool append_payload(const uint8_t* payload) {
+        size_t offset = packet.size();
+        packet.resize(offset + currunt_payload_len);
+        if (currunt_payload_len > 0) {
+            memcpy(packet.data() + offset, payload, currunt_payload_len);
+        }
+        segment_pending = !is_last_packet;
+        return is_last_packet;
     }
 
    private:
@@ -190,6 +160,182 @@ class UciCtrlPacket : public UciCtrlPcketBase {
     }
 };
 
+/**
+ * @brief CORE_SET_CONFIG 多参数批量配置
+ * 以TLV形式累积多个参数，由一条SET_CONFIG命令一次下发，整套PHY参数只需一次UCI往返。
+ * 同一参数重复添加时覆盖前值。缓冲区定长，不分配堆内存。
+ */
+class UciConfigBatch {
+   public:
+    static constexpr uint8_t MAX_PARAMS = 16;
+    static constexpr uint16_t MAX_TLV_LEN = 96;
+
+    void clear() {
+        tlv_len = 0;
+        param_count = 0;
+    }
+
+    bool add(uint8_t param_id, uint8_t val_len, const uint8_t* val) {
+        uint8_t* old_val = __find(param_id);
+        if (old_val != nullptr) {
+            if (old_val[-1] != val_len) {
+                return false;
+            }
+            memcpy(old_val, val, val_len);
+            return true;
+        }
+        if ((param_count >= MAX_PARAMS) ||
+            (tlv_len + 2 + val_len > MAX_TLV_LEN)) {
+            return false;
+        }
+        tlv[tlv_len++] = param_id;
+        tlv[tlv_len++] = val_len;
+        memcpy(tlv + tlv_len, val, val_len);
+        tlv_len += val_len;
+        param_count++;
+        return true;
+    }
+
+    bool add_u8(uint8_t param_id, uint8_t val) {
+        return add(param_id, 1, &val);
+    }
+
+    // 多字节参数按小端序下发，与单参数接口一致
+    bool add_u32(uint8_t param_id, uint32_t val) {
+        uint8_t le[4] = {(uint8_t)val, (uint8_t)(val >> 8),
+                         (uint8_t)(val >> 16), (uint8_t)(val >> 24)};
+        return add(param_id, 4, le);
+    }
+
+    uint8_t count() const { return param_count; }
+    uint16_t size() const { return tlv_len; }
+    const uint8_t* data() const { return tlv; }
+
+    /**
+     * @brief 遍历第index个参数
+     * @return index越界返回false
+     */
+    bool at(uint8_t index, uint8_t& param_id, uint8_t& val_len,
+            const uint8_t*& val) const {
+        uint16_t pos = 0;
+        for (uint8_t i = 0; i < param_count; i++) {
+            if (i == index) {
+                param_id = tlv[pos];
+                val_len = tlv[pos + 1];
+                val = tlv + pos + 2;
+                return true;
+            }
+            pos += 2 + tlv[pos + 1];
+        }
+        return false;
+    }
+
+   private:
+    uint8_t tlv[MAX_TLV_LEN];
+    uint16_t tlv_len = 0;
+    uint8_t param_count = 0;
+
+    uint8_t* __find(uint8_t param_id) {
+        uint16_t pos = 0;
+        for (uint8_t i = 0; i < param_count; i++) {
+            if (tlv[pos] == param_id) {
+                return tlv + pos + 2;
+            }
+            pos += 2 + tlv[pos + 1];
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * @brief 应用配置影子表
+ * 保存驱动最近一次写入或从芯片读回的参数值：读取直接返回影子值，写入相同值时跳过命令。
+ * 芯片复位后全部失效，需要重新同步。参数表固定，不分配堆内存。
+ */
+class UciConfigShadow {
+   public:
+    static constexpr uint8_t MAX_VAL_LEN = 4;
+
+    void invalidate() {
+        for (auto& e : entries) {
+            e.valid = false;
+        }
+    }
+
+    // 读取影子值，未同步或长度不符返回false
+    bool get(uint8_t param_id, uint8_t val_len, uint8_t* val) const {
+        const Entry* e = __find(param_id);
+        if ((e == nullptr) || !e->valid || (e->val_len != val_len)) {
+            return false;
+        }
+        memcpy(val, e->val, val_len);
+        return true;
+    }
+
+    // 影子值与val相同（写入可以跳过）
+    bool matches(uint8_t param_id, uint8_t val_len, const uint8_t* val) const {
+        const Entry* e = __find(param_id);
+        return (e != nullptr) && e->valid && (e->val_len == val_len) &&
+               (memcmp(e->val, val, val_len) == 0);
+    }
+
+    // 记录芯片上的当前值，不在表中的参数忽略
+    void store(uint8_t param_id, uint8_t val_len, const uint8_t* val) {
+        Entry* e = __find(param_id);
+        if ((e == nullptr) || (e->val_len != val_len)) {
+            return;
+        }
+        memcpy(e->val, val, val_len);
+        e->valid = true;
+    }
+
+    void store(const UciConfigBatch& batch) {
+        uint8_t param_id;
+        uint8_t val_len;
+        const uint8_t* val;
+        for (uint8_t i = 0; batch.at(i, param_id, val_len, val); i++) {
+            store(param_id, val_len, val);
+        }
+    }
+
+    // 参数表遍历，用于复位后整表回读
+    uint8_t count() const { return sizeof(entries) / sizeof(entries[0]); }
+    uint8_t id_at(uint8_t index) const { return entries[index].param_id; }
+
+   private:
+    struct Entry {
+        uint8_t param_id;
+        uint8_t val_len;
+        bool valid;
+        uint8_t val[MAX_VAL_LEN];
+    };
+    Entry entries[11] = {
+        {PARAM_CHANNEL_NUMBER_ID, 1, false, {}},
+        {PARAM_PREAMBLE_CODE_INDEX_ID, 1, false, {}},
+        {PARAM_SFD_ID_ID, 1, false, {}},
+        {PARAM_PSDU_DATA_RATE_ID, 1, false, {}},
+        {PARAM_PRF_MODE_ID, 1, false, {}},
+        {PARAM_TX_POWER_ID, 1, false, {}},
+        {PARAM_PREAMBLE_LENGTH_ID, 1, false, {}},
+        {PARAM_PHR_MODE_ID, 1, false, {}},
+        {PARAM_CX_AUTO_RX_EN_ID, 1, false, {}},
+        {PARAM_CX_RX_EN_DELAY_ID, 4, false, {}},
+        {PARAM_CX_RX_TIMEOUT_ID, 4, false, {}},
+    };
+
+    Entry* __find(uint8_t param_id) {
+        for (auto& e : entries) {
+            if (e.param_id == param_id) {
+                return &e;
+            }
+        }
+        return nullptr;
+    }
+    const Entry* __find(uint8_t param_id) const {
+        return const_cast<UciConfigShadow*>(this)->__find(param_id);
+    }
+};
+
 class UciCMD : private UciCtrlPacket {
    public:
     UciCMD() : packet(UciCtrlPacket::packet) {}
@@ -299,7 +445,7 @@ class UciCMD : private UciCtrlPacket {
     // }
 
     bool core_set_config(uint8_t param_id, uint8_t val_len,
-                         uint8_t* param_val) {
+                         const uint8_t* param_val) {
         payload.clear();
         payload.resize(3);
         mt = MT_CMD;
@@ -312,6 +458,18 @@ class UciCMD : private UciCtrlPacket {
         return build_packet(payload);
     }
 
+    // 多参数：负载为 参数个数 + 依次排列的 [ID][长度][值]
+    bool core_set_config(const UciConfigBatch& batch) {
+        payload.clear();
+        payload.push_back(batch.count());
+        payload.insert(payload.end(), batch.data(),
+                       batch.data() + batch.size());
+        mt = MT_CMD;
+        gid = GID0x03;
+        oid = CX_SET_CONFIG_CMD;
+        return build_packet(payload);
+    }
+
     bool check_core_set_config_rsp(const UciCtrlPacket& rsp) {
         if (rsp.mt != MT_RSP) {
             return false;
@@ -363,13 +521,55 @@ class UciCMD : private UciCtrlPacket {
         return true;
     }
 
+    // 多参数读取：负载为 参数个数 + 依次排列的参数ID
+    bool core_get_config(const uint8_t* param_ids, uint8_t count) {
+        payload.clear();
+        payload.push_back(count);
+        payload.insert(payload.end(), param_ids, param_ids + count);
+        mt = MT_CMD;
+        gid = GID0x03;
+        oid = CX_GET_CONFIG_CMD;
+        return build_packet(payload);
+    }
+
+    // 多参数读取响应：状态 + 参数个数 + 依次排列的 [ID][长度][值]，结果写入影子表
+    bool check_core_get_config_rsp(const UciCtrlPacket& rsp,
+                                   UciConfigShadow& shadow) {
+        if (rsp.mt != MT_RSP) {
+            return false;
+        }
+        if (rsp.gid != GID0x03) {
+            return false;
+        }
+        if (rsp.oid != CX_GET_CONFIG_CMD) {
+            return false;
+        }
+        if ((rsp.packet.size() < 2) || (rsp.packet[0] != STATUS_OK)) {
+            return false;
+        }
+        size_t pos = 2;
+        for (uint8_t i = 0; i < rsp.packet[1]; i++) {
+            if ((pos + 2 > rsp.packet.size()) ||
+                (pos + 2 + rsp.packet[pos + 1] > rsp.packet.size())) {
+                return false;
+            }
+            shadow.store(rsp.packet[pos], rsp.packet[pos + 1],
+                         rsp.packet.data() + pos + 2);
+            pos += 2 + rsp.packet[pos + 1];
+        }
+        return true;
+    }
+
     /* ---------------<Data Timestamp CMD>--------------- */
     bool cx_app_data_tx(const std::vector<uint8_t>& data) {
-        if (data.size() > CX_APP_DATA_TX_MAX_PAYLOAD_LEN) {
+        return cx_app_data_tx(data.data(), data.size());
+    }
+
+    bool cx_app_data_tx(const uint8_t* data, uint16_t len) {
+        if (len > CX_APP_DATA_TX_MAX_PAYLOAD_LEN) {
             return false;
         }
-        payload.resize(data.size());
-        payload.assign(data.begin(), data.end());
+        payload.assign(data, data + len);
         mt = MT_CMD;
         gid = GID0x03;
         oid = CX_APP_DATA_TX_CMD;
@@ -7,6 +7,7 @@
 /* --------------------------- < Max Payload len> -------------------------- */
 #define MAX_PAYLOAD_LEN                1024
 #define CX_APP_DATA_TX_MAX_PAYLOAD_LEN (MAX_PAYLOAD_LEN - 4)
+#define UCI_MAX_PACKET_SIZE            (UCI_CTRL_PKT_HDR_SIZE + MAX_PAYLOAD_LEN)
 
 /* ------------------------- < Message type (MT) > ------------------------- */
 #define MT_CMD 0x01
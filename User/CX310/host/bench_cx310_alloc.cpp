@@ -0,0 +1,181 @@
+/**
+ * @brief CX310 驱动命令路径堆分配计数
+ * 替换全局 operator new 计数，驱动 CX310<SimCX310Adapter> 发送数据帧和执行同步配置命令，
+ * 统计每次操作在驱动内部产生的分配次数。模拟芯片自身的分配（事件队列、统计记录）不计入。
+ * 预热阶段让异步命令队列的每个槽位都用过一次，复用的命令缓冲区完成首次扩容后再开始计数。
+ *
+ * 构建运行（在 User/CX310/host 目录下）：
+ *   g++ -std=c++17 -O2 -Wall -I. -o bench_cx310_alloc bench_cx310_alloc.cpp && ./bench_cx310_alloc
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "../CX310.hpp"
+#include "sim_cx310_adapter.hpp"
+
+// 计数版operator new内联后GCC会误报malloc/free与new/delete不匹配
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+static bool counting = false;
+static uint64_t alloc_count = 0;
+
+void *operator new(std::size_t size)
+{
+    if (counting)
+    {
+        alloc_count++;
+    }
+    void *p = std::malloc(size ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// 模拟芯片内部暂停计数，只统计驱动自身的分配
+class CountPause
+{
+  public:
+    CountPause() : saved(counting)
+    {
+        counting = false;
+    }
+    ~CountPause()
+    {
+        counting = saved;
+    }
+
+  private:
+    bool saved;
+};
+
+class BenchSim : public SimCX310Adapter
+{
+  public:
+    bool send(std::vector<uint8_t> &tx_data) override
+    {
+        CountPause pause;
+        return SimCX310Adapter::send(tx_data);
+    }
+
+    uint16_t get_recv_data(uint8_t *rx_data, uint16_t cap) override
+    {
+        CountPause pause;
+        return SimCX310Adapter::get_recv_data(rx_data, cap);
+    }
+};
+
+using Uwb = CX310<BenchSim>;
+
+// 驱动处理完全部挂起的事件（响应、发送完成通知）
+static void drain(Uwb &uwb)
+{
+    BenchSim &sim = uwb.get_interface();
+    for (;;)
+    {
+        bool more;
+        {
+            CountPause pause;
+            more = sim.advance_to_next_event();
+        }
+        if (!more)
+        {
+            break;
+        }
+        uwb.update();
+    }
+}
+
+// 发送一帧并处理到发送完成
+static void run_transmit(Uwb &uwb, const uint8_t *data, uint16_t len)
+{
+    uwb.data_transmit(data, len);
+    drain(uwb);
+}
+
+// 切换信道并回读，交替取值保证每次都真正下发命令
+static void run_config(Uwb &uwb, uint32_t i)
+{
+    uint8_t channel = 0;
+    uwb.set_channel((i & 1) ? PARAM_CHANNEL_NUMBER_9 : PARAM_CHANNEL_NUMBER_5);
+    uwb.get_channel(channel);
+    uwb.set_recv_mode();
+}
+
+template <typename Op> static double measure(Uwb &uwb, uint32_t iterations, Op op)
+{
+    alloc_count = 0;
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        counting = true;
+        op(uwb, i);
+        counting = false;
+    }
+    return (double)alloc_count / iterations;
+}
+
+int main()
+{
+    const uint32_t iterations = 1000;
+    auto uwb = std::make_unique<Uwb>();
+    uwb->init();
+    if (!uwb->is_init_success())
+    {
+        printf("init failed\n");
+        return 1;
+    }
+
+    uint8_t frame[512];
+    for (size_t i = 0; i < sizeof(frame); i++)
+    {
+        frame[i] = (uint8_t)i;
+    }
+
+    auto tx_op = [&](Uwb &u, uint32_t) { run_transmit(u, frame, sizeof(frame)); };
+
+    // 预热
+    for (uint32_t i = 0; i < 2 * UWB_CMD_QUEUE_DEPTH; i++)
+    {
+        tx_op(*uwb, i);
+        run_config(*uwb, i);
+    }
+
+    double tx_allocs = measure(*uwb, iterations, tx_op);
+    double cfg_allocs = measure(*uwb, iterations, run_config);
+
+    BenchSim &sim = uwb->get_interface();
+    printf("data_transmit (%u bytes):          %.3f allocations/frame\n", (unsigned)sizeof(frame), tx_allocs);
+    printf("set_channel+get_channel+set_recv_mode: %.3f allocations/iteration\n", cfg_allocs);
+    printf("frames on air: %u, commands: %u\n", (unsigned)sim.stats.tx_frames, (unsigned)sim.stats.cmds);
+    return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * @brief CX310 发送->接收切换时间测量（主机端模拟）
+ * 用 CX310<SimCX310Adapter> 对比两种回到接收的方式：
+ *   - 主机补发：未开启自动接收，驱动收到发送完成通知后在update()中补发APP_DATA_RX命令
+ *   - 自动接收：set_auto_recv(UWB_AUTO_RX_DELAY_US, 0)，芯片在发送完成后自行回到接收
+ * 对每种方式统计发送完成到接收机打开的时间、每帧SPI传输次数，
+ * 并扫描从机应答相对发送完成的偏移，找出主机能听到的最早应答时刻（对应TDMA_STARTUP_DELAY_MS的下限）。
+ * 每个INT事件到任务调用update()之间加入可配置的唤醒延时：主机补发路径的切换时间随唤醒延时增长，
+ * 自动接收只取决于芯片上配置的延时。
+ *
+ * 构建运行（在 User/CX310/host 目录下）：
+ *   g++ -std=c++17 -O2 -Wall -I. -o bench_cx310_turnaround bench_cx310_turnaround.cpp && ./bench_cx310_turnaround
+ */
+#include <cstdio>
+#include <memory>
+
+#include "../CX310.hpp"
+#include "sim_cx310_adapter.hpp"
+
+// 与uwb_task.cpp一致
+#define UWB_AUTO_RX_DELAY_US 100
+#define UWB_AUTO_RX_TIMEOUT_US 0
+
+using Uwb = CX310<SimCX310Adapter>;
+
+struct Result
+{
+    double turnaround_avg_us;
+    uint64_t turnaround_max_us;
+    double spi_per_frame;
+    uint32_t earliest_reply_us; // 能收到的最早应答偏移，0xFFFFFFFF表示扫描范围内都收不到
+};
+
+// INT有效到uwb_comm_task开始处理的延时
+static uint32_t wake_latency_us = 0;
+
+static std::unique_ptr<Uwb> make_uwb(bool auto_rx)
+{
+    auto uwb = std::make_unique<Uwb>();
+    SimCX310Adapter &sim = uwb->get_interface();
+    sim.spi_hz = 22500000;
+    sim.spi_overhead_us = 40;
+    sim.radio_latency_us = 150;
+    uwb->init();
+    if (auto_rx)
+    {
+        uwb->set_auto_recv(UWB_AUTO_RX_DELAY_US, UWB_AUTO_RX_TIMEOUT_US);
+    }
+    uwb->set_recv_mode();
+    return uwb;
+}
+
+// 与uwb_comm_task一致：每个事件（INT有效）后调用update()并取出接收数据
+static void drain(Uwb &uwb)
+{
+    SimCX310Adapter &sim = uwb.get_interface();
+    while (sim.advance_to_next_event())
+    {
+        sim.advance_us(wake_latency_us);
+        while (uwb.has_recv_data())
+        {
+            uwb.recv_data_pop();
+        }
+    }
+}
+
+static Result measure(bool auto_rx, uint32_t frames)
+{
+    Result r = {};
+    auto uwb = make_uwb(auto_rx);
+    SimCX310Adapter &sim = uwb->get_interface();
+    drain(*uwb);
+    sim.clear_stats();
+
+    uint8_t frame[64] = {0xAB, 0xCD};
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        uwb->data_transmit(frame, sizeof(frame));
+        drain(*uwb);
+        uint64_t turnaround = sim.rx_on_from() - sim.air_tx.back().end_us;
+        total += turnaround;
+        if (turnaround > r.turnaround_max_us)
+        {
+            r.turnaround_max_us = turnaround;
+        }
+    }
+    r.turnaround_avg_us = (double)total / frames;
+    r.spi_per_frame = (double)sim.stats.spi_transfers / frames;
+
+    // 扫描应答偏移：发送后在end_us + offset注入一帧从机应答，看是否被接收
+    r.earliest_reply_us = 0xFFFFFFFF;
+    for (uint32_t offset = 0; offset <= 1000; offset += 10)
+    {
+        auto probe = make_uwb(auto_rx);
+        SimCX310Adapter &ps = probe->get_interface();
+        drain(*probe);
+        ps.clear_stats();
+        probe->data_transmit(frame, sizeof(frame));
+        // 发送完成时刻在命令处理后才确定，先推进到TX_NTF就绪
+        while (ps.air_tx.empty() && ps.advance_to_next_event())
+        {
+            ps.advance_us(wake_latency_us);
+            probe->update();
+        }
+        if (ps.air_tx.empty())
+        {
+            break;
+        }
+        ps.inject_rx(frame, sizeof(frame), ps.air_tx.back().end_us + offset);
+        drain(*probe);
+        if (ps.stats.rx_delivered > 0)
+        {
+            r.earliest_reply_us = offset;
+            break;
+        }
+    }
+    return r;
+}
+
+static void print(const char *name, const Result &r)
+{
+    printf("%-12s turnaround avg %6.1f us, max %4llu us, %.2f SPI transfers/frame, ", name, r.turnaround_avg_us,
+           (unsigned long long)r.turnaround_max_us, r.spi_per_frame);
+    if (r.earliest_reply_us == 0xFFFFFFFF)
+    {
+        printf("no reply heard within 1000 us\n");
+    }
+    else
+    {
+        printf("earliest reply heard at +%u us\n", (unsigned)r.earliest_reply_us);
+    }
+}
+
+int main()
+{
+    const uint32_t frames = 100;
+    const uint32_t latencies[] = {0, 50, 200};
+    for (uint32_t latency : latencies)
+    {
+        wake_latency_us = latency;
+        printf("task wake latency %u us:\n", (unsigned)latency);
+        print("host re-arm", measure(false, frames));
+        print("auto-rx", measure(true, frames));
+    }
+    return 0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * @brief 主机端 EasyLogger 桩头文件
+ * CX310.hpp 依赖 elog.h，主机编译时以 -I. 引入本文件，日志全部为空操作。
+ * 参数仍然传给空函数，避免只在日志中使用的变量产生未使用警告。
+ */
+static inline void elog_host_nop(const char* tag, ...) { (void)tag; }
+
+#define elog_a(tag, ...) elog_host_nop(tag, __VA_ARGS__)
+#define elog_e(tag, ...) elog_host_nop(tag, __VA_ARGS__)
+#define elog_w(tag, ...) elog_host_nop(tag, __VA_ARGS__)
+#define elog_i(tag, ...) elog_host_nop(tag, __VA_ARGS__)
+#define elog_d(tag, ...) elog_host_nop(tag, __VA_ARGS__)
+#define elog_v(tag, ...) elog_host_nop(tag, __VA_ARGS__)
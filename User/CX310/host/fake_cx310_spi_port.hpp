@@ -0,0 +1,133 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#include "../cx310_spi_transport.hpp"
+
+/**
+ * @brief 主机端模拟的 CX310 SPI 端口，用于在 PC 上驱动 CX310SpiTransport 状态机
+ *
+ * 单线程模型：没有真实中断，“中断”在 wait_event() 中按脚本触发。
+ *   - rdy_delay_events：拉低NSS后经过几个虚拟毫秒RDY才有效（0表示立即有效）
+ *   - stall_dma：DMA启动后永不完成，用于验证超时/中止路径
+ *   - fail_start / inject_error：DMA启动失败 / 完成时报告错误
+ *   - rx_frames：从机待上送的UCI包（含4字节包头）
+ * wait_event 每推进一步消耗 1ms 虚拟时间，无事件时消耗完整的超时时间，超时判断与目标板一致。
+ *
+ * 用法：
+ *   FakeCX310SpiPort port;
+ *   CX310SpiTransport transport(port);
+ *   port.attach(&transport);
+ *   port.rdy_delay_events = 2;
+ *   transport.send(buf, len);      // port.tx_frames 记录发出的数据
+ */
+class FakeCX310SpiPort : public ICX310SpiPort {
+   public:
+    // 脚本参数
+    uint32_t rdy_delay_events = 0;
+    bool stall_dma = false;
+    bool fail_start = false;
+    bool inject_error = false;
+    std::deque<std::vector<uint8_t>> rx_frames;
+
+    // 观测结果
+    std::vector<std::vector<uint8_t>> tx_frames;
+    bool nss_asserted = false;
+    uint32_t abort_count = 0;
+    uint32_t virtual_ms = 0;
+
+    void attach(CX310SpiTransport* t) { transport = t; }
+
+    void nss_low() override {
+        nss_asserted = true;
+        rdy_countdown = rdy_delay_events;
+        rx_offset = 0;
+    }
+
+    void nss_high() override {
+        nss_asserted = false;
+        // 一次片选周期结束，当前上送包读完后出队
+        if (rx_offset > 0 && !rx_frames.empty()) {
+            rx_frames.pop_front();
+        }
+        rx_offset = 0;
+    }
+
+    bool rdy_active() override { return nss_asserted && rdy_countdown == 0; }
+
+    bool start_tx(const uint8_t* tx, uint16_t len) override {
+        if (fail_start) {
+            return false;
+        }
+        tx_frames.emplace_back(tx, tx + len);
+        dma_pending = true;
+        return true;
+    }
+
+    bool start_txrx(const uint8_t* tx, uint8_t* rx, uint16_t len) override {
+        (void)tx;
+        if (fail_start) {
+            return false;
+        }
+        // 从当前上送包中按偏移取数据，不足部分补0
+        for (uint16_t i = 0; i < len; i++) {
+            uint8_t byte = 0;
+            if (!rx_frames.empty() && rx_offset < rx_frames.front().size()) {
+                byte = rx_frames.front()[rx_offset];
+            }
+            rx[i] = byte;
+            rx_offset++;
+        }
+        dma_pending = true;
+        return true;
+    }
+
+    void abort() override {
+        dma_pending = false;
+        abort_count++;
+    }
+
+    bool wait_event(uint32_t timeout_ms) override {
+        // 每个虚拟毫秒推进一步模拟，直到有事件或超时
+        for (uint32_t i = 0; i < timeout_ms; i++) {
+            if (event_pending) {
+                break;
+            }
+            virtual_ms++;
+            __step();
+        }
+
+        bool fired = event_pending;
+        event_pending = false;
+        return fired;
+    }
+
+    void signal_event_isr() override { event_pending = true; }
+
+    uint32_t now_ms() override { return virtual_ms; }
+
+   private:
+    CX310SpiTransport* transport = nullptr;
+    uint32_t rdy_countdown = 0;
+    size_t rx_offset = 0;
+    bool dma_pending = false;
+    bool event_pending = false;
+
+    // 推进一步：先让RDY生效，再完成进行中的DMA
+    void __step() {
+        if (nss_asserted && rdy_countdown > 0) {
+            if (--rdy_countdown == 0) {
+                transport->on_rdy_isr();
+            }
+        } else if (dma_pending && !stall_dma) {
+            dma_pending = false;
+            if (inject_error) {
+                transport->on_dma_error_isr();
+            } else {
+                transport->on_dma_done_isr();
+            }
+        }
+    }
+};
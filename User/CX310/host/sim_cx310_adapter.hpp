@@ -0,0 +1,419 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "../ICX310.hpp"
+#include "../cx_uci_def.hpp"
+
+/**
+ * @brief 主机端模拟的 CX310 芯片，实现 ICX310，使 CX310<SimCX310Adapter> 驱动可在 PC 上运行
+ *
+ * 单线程、虚拟时间（微秒）模型，没有真实中断：
+ *   - 上电/复位：chip_enable()、turn_of_reset_signal() 或 CORE_DEVICE_RESET_CMD 后上送 DEVICE_STATUS_NTF(READY)
+ *   - 每条 CMD 回复一条 RSP（分段命令每段一条），SET/GET_CONFIG 读写内部参数表
+ *   - CX_APP_DATA_TX_CMD：空口发送完成后上送 CX_APP_DATA_TX_NTF；开启自动接收时按 RX_EN_DELAY 回到接收
+ *   - inject_rx()：按指定时刻注入空口帧，接收机打开时上送 CX_APP_DATA_RX_NTF，否则计入 rx_missed
+ * 时间开销：
+ *   - SPI：每次 send()/get_recv_data() 消耗 spi_overhead_us + 字节数 * 8 / spi_hz
+ *   - 空口：radio_latency_us + 字节数 * 8 / PSDU速率（由 PARAM_PSDU_DATA_RATE_ID 当前值决定）
+ *   - get_system_1ms_ticks() 每次调用消耗 poll_cost_us，驱动忙等时虚拟时间照常推进
+ * 模型参数在 init() 之前设置；测量前可调用 clear_stats() 去掉启动阶段的开销。
+ * 驱动依赖 elog.h，主机编译时加 -I. 使用同目录下的桩头文件；完整示例见 sim_cx310_main.cpp。
+ *
+ * 用法（与 uwb_comm_task 的主循环一致：INT有效时调用 update()/has_recv_data()）：
+ *   auto uwb = std::make_unique<CX310<SimCX310Adapter>>();
+ *   SimCX310Adapter& sim = uwb->get_interface();
+ *   sim.spi_hz = 11250000;
+ *   uwb->init();
+ *   sim.inject_rx(frame, sizeof(frame), sim.now_us() + 500);
+ *   uwb->data_transmit(buf, len);                  // sim.air_tx 记录空口发出的帧
+ *   while (sim.advance_to_next_event()) {
+ *       while (uwb->has_recv_data()) { ... uwb->recv_data_pop(); }
+ *   }
+ */
+class SimCX310Adapter : public ICX310 {
+   public:
+    // 空口发出的帧
+    struct AirFrame {
+        uint64_t start_us;    // 开始发送
+        uint64_t end_us;      // 发送完成（TX_NTF就绪）
+        std::vector<uint8_t> data;
+    };
+
+    // 统计
+    struct Stats {
+        uint32_t spi_transfers;
+        uint32_t spi_bytes;
+        uint64_t spi_busy_us;    // SPI传输累计占用时间
+        uint32_t cmds;
+        uint32_t tx_frames;
+        uint32_t rx_delivered;    // 已上送的接收通知
+        uint32_t rx_missed;       // 到达时接收机未打开而丢失的帧
+    };
+
+    // 模型参数
+    uint32_t spi_hz = 22500000;        // SPI时钟
+    uint32_t spi_overhead_us = 20;     // 每次传输的片选/RDY握手开销
+    uint32_t rsp_latency_us = 30;      // 芯片处理命令到RSP就绪的时间
+    uint32_t radio_latency_us = 150;   // 每帧固定的空口开销（前导码、PHR等）
+    uint32_t boot_time_us = 50000;     // 上电/复位到DEVICE_STATUS_NTF就绪的时间
+    uint32_t poll_cost_us = 1;         // get_system_1ms_ticks()每次调用推进的时间
+
+    // 观测结果
+    std::vector<AirFrame> air_tx;
+    Stats stats = {};
+
+    SimCX310Adapter() { __load_defaults(); }
+
+    /* ----------------------------- ICX310 ------------------------------ */
+    void reset_pin_init() override {}
+    void generate_reset_signal() override { __power_off(); }
+    void turn_of_reset_signal() override { __boot(); }
+    void chip_en_init() override {}
+    void chip_enable() override { __boot(); }
+    void chip_disable() override { __power_off(); }
+    void commuication_peripheral_init() override {}
+
+    bool send(std::vector<uint8_t>& tx_data) override {
+        __advance();
+        __spi_transfer(tx_data.size());
+        if (!powered || tx_data.size() < UCI_CTRL_PKT_HDR_SIZE) {
+            return false;
+        }
+        __process_cmd(tx_data);
+        return true;
+    }
+
+    uint16_t get_recv_data(uint8_t* rx_data, uint16_t cap) override {
+        __advance();
+        auto it = pending.begin();
+        if (it == pending.end() || it->first > clock_us) {
+            return 0;
+        }
+        uint16_t len = it->second.size();
+        if (len > cap) {
+            return 0;
+        }
+        memcpy(rx_data, it->second.data(), len);
+        last_int_us = it->first;
+        pending.erase(it);
+        __spi_transfer(len);
+        return len;
+    }
+
+    // 仿真中每个数据包都有独立的就绪时刻，不存在中断合并
+    uint64_t get_recv_int_us() override { return last_int_us; }
+
+    uint32_t get_system_1ms_ticks() override {
+        clock_us += poll_cost_us;
+        return (uint32_t)(clock_us / 1000);
+    }
+
+    void delay_ms(uint32_t ms) override { clock_us += (uint64_t)ms * 1000; }
+
+    /* ------------------------------ 仿真控制 ----------------------------- */
+    uint64_t now_us() const { return clock_us; }
+
+    // 推进虚拟时间（模拟主机侧的处理延时，如任务唤醒）
+    void advance_us(uint64_t us) { clock_us += us; }
+
+    // 与CX310_SlaveSpiAdapter一致：最近一次上送数据包就绪（INT有效）的时刻
+    uint64_t get_last_int_us() const { return last_int_us; }
+
+    // INT引脚是否有效：有已就绪、待读取的数据包
+    bool int_active() {
+        __advance();
+        return !pending.empty() && pending.begin()->first <= clock_us;
+    }
+
+    // 注入一帧在at_us时刻开始到达的空口数据
+    void inject_rx(const uint8_t* data, uint16_t len, uint64_t at_us) {
+        air_rx.push_back({at_us, at_us + __airtime_us(len), std::vector<uint8_t>(data, data + len)});
+    }
+
+    // 把虚拟时间推进到下一个事件（数据包就绪或空口帧到达完成），没有后续事件时返回false
+    bool advance_to_next_event() {
+        __advance();
+        uint64_t next = UINT64_MAX;
+        if (!pending.empty()) {
+            next = pending.begin()->first;
+        }
+        for (const AirFrame& f : air_rx) {
+            if (f.end_us < next) {
+                next = f.end_us;
+            }
+        }
+        if (next == UINT64_MAX) {
+            return false;
+        }
+        if (next > clock_us) {
+            clock_us = next;
+        }
+        __advance();
+        return true;
+    }
+
+    // 接收机当前是否打开
+    bool rx_on() const { return rx_on_from_us <= clock_us && clock_us < rx_off_at_us; }
+
+    // 接收机打开（或将要打开）的时刻，关闭时返回UINT64_MAX
+    uint64_t rx_on_from() const { return rx_on_from_us; }
+
+    void clear_stats() {
+        stats = {};
+        air_tx.clear();
+    }
+
+    // 读取内部参数表（用于核对驱动下发的配置）
+    bool get_param(uint8_t param_id, std::vector<uint8_t>& val) const {
+        auto it = params.find(param_id);
+        if (it == params.end()) {
+            return false;
+        }
+        val = it->second;
+        return true;
+    }
+
+   private:
+    uint64_t clock_us = 0;
+    uint64_t last_int_us = 0;
+    bool powered = false;
+    uint64_t tx_busy_until_us = 0;
+    uint64_t rx_on_from_us = UINT64_MAX;    // 接收机打开时刻，UINT64_MAX表示关闭
+    uint64_t rx_off_at_us = UINT64_MAX;     // 接收超时关闭时刻
+    std::multimap<uint64_t, std::vector<uint8_t>> pending;    // 按就绪时刻排序的上送包
+    std::deque<AirFrame> air_rx;
+    std::map<uint8_t, std::vector<uint8_t>> params;
+    std::vector<uint8_t> cmd_payload;    // 分段命令的负载拼接
+
+    void __load_defaults() {
+        params.clear();
+        params[PARAM_CHANNEL_NUMBER_ID] = {PARAM_CHANNEL_NUMBER_5};
+        params[PARAM_PREAMBLE_CODE_INDEX_ID] = {9};
+        params[PARAM_SFD_ID_ID] = {2};
+        params[PARAM_PSDU_DATA_RATE_ID] = {PARAM_PSDU_DATA_RATE_7_8};
+        params[PARAM_PRF_MODE_ID] = {PARAM_PRF_NOMINAL_64_M};
+        params[PARAM_TX_POWER_ID] = {3};
+        params[PARAM_PREAMBLE_LENGTH_ID] = {PARAM_PREAMBLE_LEN_BPRF_64};
+        params[PARAM_PHR_MODE_ID] = {PARAM_PHYDATARATE_DRHM_HR};
+        params[PARAM_CX_AUTO_RX_EN_ID] = {0};
+        params[PARAM_CX_RX_EN_DELAY_ID] = {0, 0, 0, 0};
+        params[PARAM_CX_RX_TIMEOUT_ID] = {0, 0, 0, 0};
+    }
+
+    void __power_off() {
+        powered = false;
+        pending.clear();
+        cmd_payload.clear();
+        __rx_off();
+    }
+
+    void __boot() {
+        __power_off();
+        __load_defaults();
+        powered = true;
+        tx_busy_until_us = 0;
+        __queue(clock_us + boot_time_us, MT_NTF, GID0x00, CORE_DEVICE_STATUS_NTF, {DEVICE_STATE_READY});
+    }
+
+    void __spi_transfer(size_t bytes) {
+        uint64_t cost = spi_overhead_us + (uint64_t)bytes * 8 * 1000000 / spi_hz;
+        clock_us += cost;
+        stats.spi_transfers++;
+        stats.spi_bytes += bytes;
+        stats.spi_busy_us += cost;
+    }
+
+    void __queue(uint64_t ready_us, uint8_t mt, uint8_t gid, uint8_t oid, const std::vector<uint8_t>& payload) {
+        std::vector<uint8_t> pkt(UCI_CTRL_PKT_HDR_SIZE);
+        pkt[0] = (uint8_t)((mt << 5) | (gid & 0x0F));
+        pkt[1] = oid & 0x3F;
+        pkt[2] = (uint8_t)(payload.size() >> 8);
+        pkt[3] = (uint8_t)payload.size();
+        pkt.insert(pkt.end(), payload.begin(), payload.end());
+        pending.emplace(ready_us, std::move(pkt));
+    }
+
+    void __rsp(uint8_t gid, uint8_t oid, const std::vector<uint8_t>& payload) {
+        __queue(clock_us + rsp_latency_us, MT_RSP, gid, oid, payload);
+    }
+
+    uint32_t __param_u32(uint8_t param_id) const {
+        auto it = params.find(param_id);
+        uint32_t val = 0;
+        if (it != params.end()) {
+            for (size_t i = 0; i < it->second.size() && i < 4; i++) {
+                val |= (uint32_t)it->second[i] << (8 * i);
+            }
+        }
+        return val;
+    }
+
+    uint32_t __psdu_rate_bps() const {
+        switch (__param_u32(PARAM_PSDU_DATA_RATE_ID)) {
+            case PARAM_PSDU_DATA_RATE_0_85:
+                return 850000;
+            case PARAM_PSDU_DATA_RATE_6_81:
+                return 6810000;
+            case PARAM_PSDU_DATA_RATE_27_24:
+                return 27240000;
+            case PARAM_PSDU_DATA_RATE_31_2:
+                return 31200000;
+            case PARAM_PSDU_DATA_RATE_7_8:
+            default:
+                return 7800000;
+        }
+    }
+
+    uint64_t __airtime_us(size_t bytes) const {
+        return radio_latency_us + (uint64_t)bytes * 8 * 1000000 / __psdu_rate_bps();
+    }
+
+    void __rx_on(uint64_t from_us) {
+        rx_on_from_us = from_us;
+        uint32_t timeout = __param_u32(PARAM_CX_RX_TIMEOUT_ID);
+        rx_off_at_us = timeout ? from_us + timeout : UINT64_MAX;
+    }
+
+    void __rx_off() {
+        rx_on_from_us = UINT64_MAX;
+        rx_off_at_us = UINT64_MAX;
+    }
+
+    // 处理已到达完成的空口帧：到达开始时接收机打开且未在发送，则上送接收通知
+    void __advance() {
+        while (!air_rx.empty() && air_rx.front().end_us <= clock_us) {
+            AirFrame& f = air_rx.front();
+            bool listening = powered && rx_on_from_us <= f.start_us && f.end_us <= rx_off_at_us &&
+                             f.start_us >= tx_busy_until_us;
+            if (listening && f.data.size() + 2 <= MAX_PAYLOAD_LEN) {
+                std::vector<uint8_t> payload;
+                payload.reserve(f.data.size() + 2);
+                payload.push_back((uint8_t)f.data.size());
+                payload.push_back((uint8_t)(f.data.size() >> 8));
+                payload.insert(payload.end(), f.data.begin(), f.data.end());
+                __queue(f.end_us, MT_NTF, GID0x03, CX_APP_DATA_RX_NTF, payload);
+                stats.rx_delivered++;
+            } else {
+                stats.rx_missed++;
+            }
+            air_rx.pop_front();
+        }
+    }
+
+    void __process_cmd(const std::vector<uint8_t>& pkt) {
+        uint8_t mt = (pkt[0] >> 5) & 0x07;
+        uint8_t pbf = (pkt[0] >> 4) & 0x01;
+        uint8_t gid = pkt[0] & 0x0F;
+        uint8_t oid = pkt[1] & 0x3F;
+        if (mt != MT_CMD) {
+            return;
+        }
+
+        stats.cmds++;
+        cmd_payload.insert(cmd_payload.end(), pkt.begin() + UCI_CTRL_PKT_HDR_SIZE, pkt.end());
+        if (pbf == PBF_SEGMENT) {
+            // 中间分段只确认，收齐后再执行
+            __rsp(gid, oid, {STATUS_OK});
+            return;
+        }
+        std::vector<uint8_t> payload;
+        payload.swap(cmd_payload);
+
+        if (gid == GID0x00) {
+            switch (oid) {
+                case CORE_DEVICE_RESET_CMD:
+                    __rsp(gid, oid, {STATUS_OK});
+                    __load_defaults();
+                    __rx_off();
+                    __queue(clock_us + boot_time_us, MT_NTF, GID0x00, CORE_DEVICE_STATUS_NTF, {DEVICE_STATE_READY});
+                    break;
+                default:
+                    __rsp(gid, oid, {STATUS_OK});
+                    break;
+            }
+            return;
+        }
+        if (gid != GID0x03) {
+            __rsp(gid, oid, {STATUS_UNKNOWN_GID});
+            return;
+        }
+
+        switch (oid) {
+            case CX_APP_DATA_TX_CMD: {
+                __rsp(gid, oid, {STATUS_OK});
+                uint64_t start = clock_us + rsp_latency_us;
+                if (start < tx_busy_until_us) {
+                    start = tx_busy_until_us;
+                }
+                uint64_t end = start + __airtime_us(payload.size());
+                tx_busy_until_us = end;
+                air_tx.push_back({start, end, payload});
+                stats.tx_frames++;
+                __queue(end, MT_NTF, GID0x03, CX_APP_DATA_TX_NTF, {STATUS_OK});
+                // 发送期间接收机关闭，完成后按自动接收配置回到接收
+                if (__param_u32(PARAM_CX_AUTO_RX_EN_ID)) {
+                    __rx_on(end + __param_u32(PARAM_CX_RX_EN_DELAY_ID));
+                } else {
+                    __rx_off();
+                }
+                break;
+            }
+            case CX_APP_DATA_RX_CMD:
+                __rsp(gid, oid, {STATUS_OK});
+                __rx_on(clock_us > tx_busy_until_us ? clock_us : tx_busy_until_us);
+                break;
+            case CX_APP_DATA_STOP_RX_CMD:
+                __rsp(gid, oid, {STATUS_OK});
+                __rx_off();
+                break;
+            case CX_SET_CONFIG_CMD:
+                __rsp(gid, oid, {__set_config(payload)});
+                break;
+            case CX_GET_CONFIG_CMD:
+                __rsp(gid, oid, __get_config(payload));
+                break;
+            default:
+                __rsp(gid, oid, {STATUS_UNKNOWN_OID});
+                break;
+        }
+    }
+
+    // 负载：参数个数 + 依次排列的 [ID][长度][值]
+    uint8_t __set_config(const std::vector<uint8_t>& payload) {
+        if (payload.empty()) {
+            return STATUS_SYNTAX_ERROR;
+        }
+        size_t pos = 1;
+        for (uint8_t i = 0; i < payload[0]; i++) {
+            if (pos + 2 > payload.size() || pos + 2 + payload[pos + 1] > payload.size()) {
+                return STATUS_INVALID_MESSAGE_SIZE;
+            }
+            params[payload[pos]].assign(payload.begin() + pos + 2, payload.begin() + pos + 2 + payload[pos + 1]);
+            pos += 2 + payload[pos + 1];
+        }
+        return STATUS_OK;
+    }
+
+    // 负载：参数个数 + 参数ID；响应：状态 + 参数个数 + 依次排列的 [ID][长度][值]
+    std::vector<uint8_t> __get_config(const std::vector<uint8_t>& payload) {
+        if (payload.empty() || payload.size() < 1u + payload[0]) {
+            return {STATUS_SYNTAX_ERROR};
+        }
+        std::vector<uint8_t> rsp = {STATUS_OK, payload[0]};
+        for (uint8_t i = 0; i < payload[0]; i++) {
+            uint8_t param_id = payload[1 + i];
+            auto it = params.find(param_id);
+            if (it == params.end()) {
+                return {STATUS_INVALID_PARAM};
+            }
+            rsp.push_back(param_id);
+            rsp.push_back((uint8_t)it->second.size());
+            rsp.insert(rsp.end(), it->second.begin(), it->second.end());
+        }
+        return rsp;
+    }
+};
@@ -0,0 +1,160 @@
+/**
+ * @brief CX310SpiTransport 状态机主机端测试
+ * 用 FakeCX310SpiPort 脚本化 RDY/DMA 行为，覆盖正常收发、RDY超时、DMA启动失败、
+ * DMA错误、DMA卡死（超时中止）和包头长度超出缓冲区几条路径。
+ *
+ * 构建运行（在 User/CX310/host 目录下）：
+ *   g++ -std=c++17 -Wall -o test_cx310_spi_transport test_cx310_spi_transport.cpp && ./test_cx310_spi_transport
+ */
+#include <cstdio>
+
+#include "fake_cx310_spi_port.hpp"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(cond))                                                                                                   \
+        {                                                                                                              \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+struct Fixture
+{
+    FakeCX310SpiPort port;
+    CX310SpiTransport transport{port};
+    Fixture() { port.attach(&transport); }
+};
+
+static void test_send_ok()
+{
+    printf("send: RDY delayed, DMA completes\n");
+    Fixture f;
+    f.port.rdy_delay_events = 3;
+    const uint8_t pkt[] = {0x20, 0x00, 0x00, 0x01, 0xAA};
+
+    CHECK(f.transport.send(pkt, sizeof(pkt)));
+    CHECK(f.port.tx_frames.size() == 1);
+    CHECK(f.port.tx_frames[0].size() == sizeof(pkt));
+    CHECK(!f.port.nss_asserted);
+    CHECK(f.transport.get_state() == CX310SpiTransport::IDLE);
+    CHECK(f.transport.get_stats().tx_frames == 1);
+}
+
+static void test_rdy_timeout()
+{
+    printf("send: RDY never asserts -> timeout\n");
+    Fixture f;
+    f.port.rdy_delay_events = CX310SpiTransport::RDY_TIMEOUT_MS * 2;
+    const uint8_t pkt[] = {0x20, 0x00, 0x00, 0x00};
+
+    CHECK(!f.transport.send(pkt, sizeof(pkt)));
+    CHECK(f.port.tx_frames.empty());
+    CHECK(!f.port.nss_asserted);
+    CHECK(f.transport.get_state() == CX310SpiTransport::IDLE);
+    CHECK(f.transport.get_stats().rdy_timeouts == 1);
+    CHECK(f.port.virtual_ms >= CX310SpiTransport::RDY_TIMEOUT_MS);
+}
+
+static void test_dma_start_fail()
+{
+    printf("send: DMA fails to start\n");
+    Fixture f;
+    f.port.fail_start = true;
+    const uint8_t pkt[] = {0x20, 0x00, 0x00, 0x00};
+
+    CHECK(!f.transport.send(pkt, sizeof(pkt)));
+    CHECK(!f.port.nss_asserted);
+    CHECK(f.transport.get_state() == CX310SpiTransport::IDLE);
+    CHECK(f.transport.get_stats().dma_errors == 1);
+    CHECK(f.port.abort_count == 0);
+}
+
+static void test_dma_error()
+{
+    printf("send: DMA reports an error\n");
+    Fixture f;
+    f.port.inject_error = true;
+    const uint8_t pkt[] = {0x20, 0x00, 0x00, 0x00};
+
+    CHECK(!f.transport.send(pkt, sizeof(pkt)));
+    CHECK(!f.port.nss_asserted);
+    CHECK(f.transport.get_state() == CX310SpiTransport::IDLE);
+    CHECK(f.transport.get_stats().dma_errors == 1);
+    CHECK(f.transport.get_stats().tx_frames == 0);
+
+    // 错误恢复后可以继续发送
+    f.port.inject_error = false;
+    CHECK(f.transport.send(pkt, sizeof(pkt)));
+}
+
+static void test_dma_stall()
+{
+    printf("send/receive: DMA stalls -> timeout and abort\n");
+    Fixture f;
+    f.port.stall_dma = true;
+    const uint8_t pkt[] = {0x20, 0x00, 0x00, 0x00};
+
+    CHECK(!f.transport.send(pkt, sizeof(pkt)));
+    CHECK(f.port.abort_count == 1);
+    CHECK(f.transport.get_stats().dma_timeouts == 1);
+    CHECK(!f.port.nss_asserted);
+    CHECK(f.transport.get_state() == CX310SpiTransport::IDLE);
+
+    uint8_t rx[32];
+    f.port.rx_frames.push_back({0x60, 0x00, 0x00, 0x00});
+    CHECK(f.transport.receive(rx, sizeof(rx)) == 0);
+    CHECK(f.port.abort_count == 2);
+    CHECK(f.transport.get_stats().dma_timeouts == 2);
+    CHECK(f.transport.get_state() == CX310SpiTransport::IDLE);
+}
+
+static void test_receive_ok()
+{
+    printf("receive: header then body\n");
+    Fixture f;
+    f.port.rx_frames.push_back({0x60, 0x01, 0x00, 0x03, 0x11, 0x22, 0x33});
+
+    uint8_t rx[32];
+    CHECK(f.transport.receive(rx, sizeof(rx)) == 7);
+    CHECK(rx[4] == 0x11 && rx[6] == 0x33);
+    CHECK(f.port.rx_frames.empty());
+    CHECK(f.transport.get_stats().rx_frames == 1);
+    CHECK(!f.port.nss_asserted);
+}
+
+static void test_receive_oversize()
+{
+    printf("receive: header length exceeds buffer\n");
+    Fixture f;
+    f.port.rx_frames.push_back({0x60, 0x01, 0x04, 0x00});
+
+    uint8_t rx[64];
+    CHECK(f.transport.receive(rx, sizeof(rx)) == 0);
+    CHECK(f.transport.get_stats().rx_oversize == 1);
+    CHECK(f.transport.get_stats().rx_frames == 0);
+    CHECK(!f.port.nss_asserted);
+    CHECK(f.transport.get_state() == CX310SpiTransport::IDLE);
+}
+
+int main()
+{
+    test_send_ok();
+    test_rdy_timeout();
+    test_dma_start_fail();
+    test_dma_error();
+    test_dma_stall();
+    test_receive_ok();
+    test_receive_oversize();
+
+    if (failures)
+    {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all passed\n");
+    return 0;
+}
@@ -0,0 +1,134 @@
+#ifndef UCI_BUFFER_HPP_
+#define UCI_BUFFER_HPP_
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief 只读数据片段（指向缓冲区内部，不拷贝）
+ * 在下一次对同一缓冲区执行 pop/push/write_span 之前有效
+ */
+struct UciSpan {
+    const uint8_t* data;
+    uint16_t len;
+};
+
+/**
+ * @brief 连续环形字节缓冲区
+ * 读写区域始终保持连续：写入空间不足时把未读数据搬回起始处，读空时读写位置归零。
+ * 因此既能让SPI DMA直接写入，也能把任意一段未读数据作为连续片段交给解析器，
+ * 不需要逐字节出入队。仅供单个任务使用，不加锁。
+ */
+template <uint16_t Capacity>
+class UciByteRing {
+   public:
+    /* 未读数据长度 */
+    uint16_t size() const { return wr - rd; }
+    bool empty() const { return wr == rd; }
+    void clear() { rd = wr = 0; }
+
+    /* 未读数据起始地址（连续 size() 字节） */
+    const uint8_t* data() const { return buf + rd; }
+
+    /**
+     * @brief 获取至少 need 字节的连续写入空间
+     * @return 写入地址，空间不足返回nullptr
+     */
+    uint8_t* write_span(uint16_t need) {
+        if (Capacity - wr < need) {
+            if (Capacity - size() < need) {
+                return nullptr;
+            }
+            // 把未读数据搬到起始处，腾出连续空间
+            uint16_t n = size();
+            memmove(buf, buf + rd, n);
+            rd = 0;
+            wr = n;
+        }
+        return buf + wr;
+    }
+
+    /* 确认写入 n 字节（配合 write_span 使用） */
+    void commit(uint16_t n) { wr += n; }
+
+    /* 拷贝写入，空间不足返回false */
+    bool write(const uint8_t* src, uint16_t n) {
+        uint8_t* dst = write_span(n);
+        if (dst == nullptr) {
+            return false;
+        }
+        memcpy(dst, src, n);
+        commit(n);
+        return true;
+    }
+
+    /* 丢弃前 n 字节未读数据 */
+    void consume(uint16_t n) {
+        rd += (n < size()) ? n : size();
+        if (rd == wr) {
+            rd = wr = 0;
+        }
+    }
+
+   private:
+    uint8_t buf[Capacity];
+    uint16_t rd = 0;
+    uint16_t wr = 0;
+};
+
+/**
+ * @brief 变长帧队列，每帧以2字节长度 + 8字节时间戳前缀存放在 UciByteRing 中
+ * front() 返回的片段直接指向内部存储，调用者处理完后 pop()。
+ */
+template <uint16_t Capacity>
+class UciFrameQueue {
+   public:
+    bool empty() const { return ring.empty(); }
+    uint16_t count() const { return frames; }
+    uint32_t dropped() const { return drop_count; }
+
+    /* 入队一帧，time_us为该帧的时间戳（如INT中断时刻），空间不足时丢弃并计数 */
+    bool push(const uint8_t* src, uint16_t len, uint64_t time_us = 0) {
+        uint8_t* dst = ring.write_span(HEADER_SIZE + len);
+        if (dst == nullptr) {
+            drop_count++;
+            return false;
+        }
+        memcpy(dst, &len, sizeof(uint16_t));
+        memcpy(dst + sizeof(uint16_t), &time_us, sizeof(uint64_t));
+        memcpy(dst + HEADER_SIZE, src, len);
+        ring.commit(HEADER_SIZE + len);
+        frames++;
+        return true;
+    }
+
+    /* 获取队首帧，time_us非空时同时取出入队时的时间戳 */
+    bool front(UciSpan& span, uint64_t* time_us = nullptr) const {
+        if (ring.empty()) {
+            return false;
+        }
+        memcpy(&span.len, ring.data(), sizeof(uint16_t));
+        if (time_us != nullptr) {
+            memcpy(time_us, ring.data() + sizeof(uint16_t), sizeof(uint64_t));
+        }
+        span.data = ring.data() + HEADER_SIZE;
+        return true;
+    }
+
+    /* 出队首帧 */
+    void pop() {
+        UciSpan span;
+        if (front(span)) {
+            ring.consume(HEADER_SIZE + span.len);
+            frames--;
+        }
+    }
+
+   private:
+    static constexpr uint16_t HEADER_SIZE = sizeof(uint16_t) + sizeof(uint64_t);
+
+    UciByteRing<Capacity> ring;
+    uint16_t frames = 0;
+    uint32_t drop_count = 0;
+};
+
+#endif    // UCI_BUFFER_HPP_
@@ -1,5 +1,7 @@
 #include "uwb_interface.hpp"
 
+#include "hptimer/hptimer.hpp"
+
 // 全局指针定义
 CX310_SlaveSpiAdapter *g_uwb_adapter = nullptr;
 
@@ -12,6 +14,39 @@ extern "C" void uwb_int_handler_wrapper(void)
     }
 }
 
+extern "C" void uwb_rdy_handler_wrapper(void)
+{
+    if (g_uwb_adapter != nullptr)
+    {
+        g_uwb_adapter->rdy_pin_irq_handler();
+    }
+}
+
+// SPI4 DMA完成/错误回调（覆盖HAL弱定义），转发给传输状态机
+extern "C" void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi == &hspi4 && g_uwb_adapter != nullptr)
+    {
+        g_uwb_adapter->spi_dma_done_irq_handler();
+    }
+}
+
+extern "C" void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi == &hspi4 && g_uwb_adapter != nullptr)
+    {
+        g_uwb_adapter->spi_dma_done_irq_handler();
+    }
+}
+
+extern "C" void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi == &hspi4 && g_uwb_adapter != nullptr)
+    {
+        g_uwb_adapter->spi_dma_error_irq_handler();
+    }
+}
+
 // 构造函数
 CX310_SlaveSpiAdapter::CX310_SlaveSpiAdapter()
 {
@@ -43,10 +78,42 @@ void CX310_SlaveSpiAdapter::int_pin_irq_handler()
     }
     if (HAL_GPIO_ReadPin(UWB_INT_GPIO_Port, UWB_INT_Pin) == GPIO_PIN_RESET)
     {
+        last_int_us = hal_hptimer_get_us64();
+        if (!int_latched)
+        {
+            int_latched_us = last_int_us;
+            int_latched = true;
+        }
         rx_semaphore.give_ISR(waswoken);
+        // 唤醒UWB任务立即读取数据，不再等待轮询
+        if (irq_notify_thread != nullptr)
+        {
+            osThreadFlagsSet(irq_notify_thread, irq_notify_flags);
+        }
     }
 }
 
+void CX310_SlaveSpiAdapter::rdy_pin_irq_handler()
+{
+    transport.on_rdy_isr();
+}
+
+void CX310_SlaveSpiAdapter::spi_dma_done_irq_handler()
+{
+    transport.on_dma_done_isr();
+}
+
+void CX310_SlaveSpiAdapter::spi_dma_error_irq_handler()
+{
+    transport.on_dma_error_isr();
+}
+
+void CX310_SlaveSpiAdapter::set_irq_notify(osThreadId_t thread, uint32_t flags)
+{
+    irq_notify_flags = flags;
+    irq_notify_thread = thread;
+}
+
 void CX310_SlaveSpiAdapter::reset_pin_init()
 {
     // 已在CubeMX中初始化并保证高电平
@@ -65,56 +132,63 @@ void CX310_SlaveSpiAdapter::turn_of_reset_signal()
 
 bool CX310_SlaveSpiAdapter::send(std::vector<uint8_t> &tx_data)
 {
-    taskENTER_CRITICAL();
-
-    nss_low();
+    return transport.send(tx_data.data(), tx_data.size());
+}
 
-    while (HAL_GPIO_ReadPin(UWB_RDY_GPIO_Port, UWB_RDY_Pin) == GPIO_PIN_SET)
+uint16_t CX310_SlaveSpiAdapter::get_recv_data(uint8_t *rx_data, uint16_t cap)
+{
+    if (rx_semaphore.take(0))
     {
+        // 取走本次通知对应的INT时刻，之后到来的中断重新锁存；锁存已被消费时退回最近一次中断时刻
+        taskENTER_CRITICAL();
+        recv_int_us = int_latched ? int_latched_us : last_int_us;
+        int_latched = false;
+        taskEXIT_CRITICAL();
+        // DMA直接写入调用者的缓冲区
+        return transport.receive(rx_data, cap);
     }
+    return 0;
+}
 
-    bool ret = HAL_SPI_Transmit(&hspi4, const_cast<uint8_t *>(tx_data.data()), tx_data.size(), HAL_MAX_DELAY) == HAL_OK;
-    nss_high();
-
-    // 退出临界区
-    taskEXIT_CRITICAL();
+bool CX310_SlaveSpiAdapter::rdy_active()
+{
+    return HAL_GPIO_ReadPin(UWB_RDY_GPIO_Port, UWB_RDY_Pin) == GPIO_PIN_RESET;
+}
 
-    return ret;
+bool CX310_SlaveSpiAdapter::start_tx(const uint8_t *tx, uint16_t len)
+{
+    return HAL_SPI_Transmit_DMA(&hspi4, const_cast<uint8_t *>(tx), len) == HAL_OK;
 }
 
-bool CX310_SlaveSpiAdapter::get_recv_data(std::queue<uint8_t> &rx_data)
+bool CX310_SlaveSpiAdapter::start_txrx(const uint8_t *tx, uint8_t *rx, uint16_t len)
 {
-    if (rx_semaphore.take(0))
+    if (tx == nullptr)
     {
+        tx = dummy_data;
+    }
+    return HAL_SPI_TransmitReceive_DMA(&hspi4, const_cast<uint8_t *>(tx), rx, len) == HAL_OK;
+}
 
-        nss_low();
-        HAL_StatusTypeDef status;
-
-        status = HAL_SPI_TransmitReceive(&hspi4, dummy_data, rx_buffer, 4, HAL_MAX_DELAY);
-        if (status != HAL_OK)
-        {
-            nss_high();
-            return false;
-        }
+void CX310_SlaveSpiAdapter::abort()
+{
+    HAL_SPI_Abort(&hspi4);
+}
 
-        recv_len = (((uint16_t)rx_buffer[2]) << 8) | rx_buffer[3];
+bool CX310_SlaveSpiAdapter::wait_event(uint32_t timeout_ms)
+{
+    return spi_event_semaphore.take(pdMS_TO_TICKS(timeout_ms));
+}
 
-        status = HAL_SPI_TransmitReceive(&hspi4, dummy_data, rx_buffer + 4, recv_len, HAL_MAX_DELAY);
-        if (status != HAL_OK)
-        {
-            nss_high();
-            return false;
-        }
-        nss_high();
+void CX310_SlaveSpiAdapter::signal_event_isr()
+{
+    BaseType_t woken = pdFALSE;
+    spi_event_semaphore.give_ISR(woken);
+    portYIELD_FROM_ISR(woken);
+}
 
-        for (int i = 0; i < recv_len + 4; i++)
-        {
-            rx_data.push(rx_buffer[i]);
-        }
-        memset(rx_buffer, 0, sizeof(rx_buffer));
-        return true;
-    }
-    return false;
+uint32_t CX310_SlaveSpiAdapter::now_ms()
+{
+    return osKernelGetTickCount();
 }
 
 void CX310_SlaveSpiAdapter::commuication_peripheral_init()
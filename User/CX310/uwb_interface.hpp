@@ -2,10 +2,10 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
-#include <queue>
 #include <vector>
 
 #include "ICX310.hpp"
+#include "cx310_spi_transport.hpp"
 #include "SemaphoreCPP.h"
 #include "cmsis_os.h"
 #include "main.h"
@@ -14,37 +14,67 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
-class CX310_SlaveSpiAdapter : public ICX310 {
+class CX310_SlaveSpiAdapter : public ICX310, public ICX310SpiPort {
    public:
     CX310_SlaveSpiAdapter();
     ~CX310_SlaveSpiAdapter();
 
    private:
-    // 接收缓冲区
-    uint8_t rx_buffer[1024];
+    // DMA全双工接收时发送的填充字节
     uint8_t dummy_data[1024];
-    uint16_t recv_len;
     BinarySemaphore rx_semaphore = {"rx_semaphore"};
+    // SPI传输事件（RDY有效/DMA完成），由中断释放
+    BinarySemaphore spi_event_semaphore = {"spi_event"};
+    CX310SpiTransport transport{*this};
     long waswoken = 0;
     bool irq_enable = false;
+    // INT引脚中断到来时需要唤醒的任务及其事件标志
+    osThreadId_t irq_notify_thread = nullptr;
+    uint32_t irq_notify_flags = 0;
+    // 最近一次INT中断的时刻（hptimer微秒），作为收发通知的时间戳
+    volatile uint64_t last_int_us = 0;
+    // 尚未被get_recv_data()消费的最早一次INT中断时刻，信号量合并多次中断时保留第一次
+    volatile uint64_t int_latched_us = 0;
+    volatile bool int_latched = false;
+    // 最近一次get_recv_data()读出的数据包对应的INT时刻
+    uint64_t recv_int_us = 0;
 
-    // HAL库SPI控制函数
-    bool hal_spi_transmit(const std::vector<uint8_t>& data);
-    bool hal_spi_receive(uint8_t* data, uint16_t size);
-
-    // NSS控制函数
-    void nss_low();
-    void nss_high();
+    // ICX310SpiPort接口实现（HAL SPI DMA）
+    void nss_low() override;
+    void nss_high() override;
+    bool rdy_active() override;
+    bool start_tx(const uint8_t* tx, uint16_t len) override;
+    bool start_txrx(const uint8_t* tx, uint8_t* rx, uint16_t len) override;
+    void abort() override;
+    bool wait_event(uint32_t timeout_ms) override;
+    void signal_event_isr() override;
+    uint32_t now_ms() override;
 
    public:
     void int_pin_irq_handler();
+    void rdy_pin_irq_handler();
+    void spi_dma_done_irq_handler();
+    void spi_dma_error_irq_handler();
+    const CX310SpiTransport::Stats& get_transport_stats() const { return transport.get_stats(); }
+    // 设置INT引脚中断时通知的任务，中断中对该任务调用osThreadFlagsSet(thread, flags)
+    void set_irq_notify(osThreadId_t thread, uint32_t flags);
+    // 最近一次INT中断的时刻（hptimer微秒），尚未发生中断时为0
+    uint64_t get_last_int_us() const {
+        // 64位读取不是原子操作，与中断写入冲突时重读
+        uint64_t t;
+        do {
+            t = last_int_us;
+        } while (t != last_int_us);
+        return t;
+    }
 
     // ICX310接口实现
     void reset_pin_init() override;
     void generate_reset_signal() override;
     void turn_of_reset_signal() override;
     bool send(std::vector<uint8_t>& tx_data) override;
-    bool get_recv_data(std::queue<uint8_t>& rx_data) override;
+    uint16_t get_recv_data(uint8_t* rx_data, uint16_t cap) override;
+    uint64_t get_recv_int_us() override { return recv_int_us; }
     void commuication_peripheral_init() override;
     void chip_en_init() override;
     void chip_enable() override;
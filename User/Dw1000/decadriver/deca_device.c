@@ -73,6 +73,8 @@ typedef struct
     uint32      txFCTRL ;           // Keep TX_FCTRL register config
     uint32      sysCFGreg ;         // Local copy of system config register
     uint8       dblbuffon;          // Double RX buffer mode flag
+    uint8       dblbuffdefer;       // Host side RX buffer is released by the application, not by dwt_isr
+    uint8       rxbuffheld;         // Host side RX buffer holds a frame not yet released by the application
     uint8       wait4resp ;         // wait4response was set with last TX start command
     uint16      sleep_mode;         // Used for automatic reloading of LDO tune and microcode at wake-up
     uint16      otp_mask ;          // Local copy of the OTP mask used in dwt_initialise call
@@ -176,6 +178,8 @@ int dwt_initialise(int config)
     uint32 ldo_tune = 0;
 
     pdw1000local->dblbuffon = 0; // - set to 0 - meaning double buffer mode is off by default
+    pdw1000local->dblbuffdefer = 0; // - set to 0 - meaning dwt_isr releases the host side RX buffer
+    pdw1000local->rxbuffheld = 0;
     pdw1000local->wait4resp = 0; // - set to 0 - meaning wait for response not active
     pdw1000local->sleep_mode = 0; // - set to 0 - meaning sleep mode has not been configured
 
@@ -2287,6 +2291,46 @@ void dwt_setdblrxbuffmode(int enable)
     dwt_write32bitreg(SYS_CFG_ID,pdw1000local->sysCFGreg) ;
 }
 
+/*! ------------------------------------------------------------------------------------------------------------------
+ * @fn dwt_setdblrxbuffdefer()
+ *
+ * @brief In double buffer mode, stop dwt_isr from toggling the host side receive buffer after the RX good callback.
+ *        The frame stays in the host side buffer (data, RX_FINFO, RX_TIME and diagnostics) until the application has
+ *        read it outside the interrupt and calls dwt_releaserxbuff(). The receiver keeps using the other buffer.
+ *
+ * input parameters
+ * @param enable - 1 to defer the release to the application, 0 to release in dwt_isr (default)
+ *
+ * output parameters
+ *
+ * no return value
+ */
+void dwt_setdblrxbuffdefer(int enable)
+{
+    pdw1000local->dblbuffdefer = (enable != 0);
+}
+
+/*! ------------------------------------------------------------------------------------------------------------------
+ * @fn dwt_releaserxbuff()
+ *
+ * @brief Release the host side receive buffer held since the last RX good callback (see dwt_setdblrxbuffdefer).
+ *        If the other buffer already holds a frame, its RX good event is raised right after the toggle.
+ *
+ * input parameters
+ *
+ * output parameters
+ *
+ * no return value
+ */
+void dwt_releaserxbuff(void)
+{
+    if (pdw1000local->rxbuffheld)
+    {
+        pdw1000local->rxbuffheld = 0;
+        dwt_write8bitoffsetreg(SYS_CTRL_ID, SYS_CTRL_HRBT_OFFSET, 1);
+    }
+}
+
 /*! ------------------------------------------------------------------------------------------------------------------
  * @fn dwt_setrxaftertxdelay()
  *
@@ -2429,8 +2473,16 @@ void dwt_isr(void)
 
         if (pdw1000local->dblbuffon)
         {
-            // Toggle the Host side Receive Buffer Pointer
-            dwt_write8bitoffsetreg(SYS_CTRL_ID, SYS_CTRL_HRBT_OFFSET, 1);
+            if (pdw1000local->dblbuffdefer)
+            {
+                // The application reads the frame later and toggles the buffer with dwt_releaserxbuff()
+                pdw1000local->rxbuffheld = 1;
+            }
+            else
+            {
+                // Toggle the Host side Receive Buffer Pointer
+                dwt_write8bitoffsetreg(SYS_CTRL_ID, SYS_CTRL_HRBT_OFFSET, 1);
+            }
         }
     }
 
@@ -2854,6 +2906,13 @@ void dwt_forcetrxoff(void)
 void dwt_syncrxbufptrs(void)
 {
     uint8  buff ;
+
+    // The host side buffer is still held by the application; pointers are realigned when it is released
+    if (pdw1000local->rxbuffheld)
+    {
+        return;
+    }
+
     // Need to make sure that the host/IC buffer pointers are aligned before starting RX
     buff = dwt_read8bitoffsetreg(SYS_STATUS_ID, 3); // Read 1 byte at offset 3 to get the 4th byte out of 5
 
@@ -1009,6 +1009,37 @@ extern "C"
      */
     void dwt_setdblrxbuffmode(int enable);
 
+    /*!
+     * ------------------------------------------------------------------------------------------------------------------
+     * @fn dwt_setdblrxbuffdefer()
+     *
+     * @brief In double buffer mode, leave the host side receive buffer to the application after the RX good callback
+     *        instead of toggling it in dwt_isr. The application reads the frame outside the interrupt and then calls
+     *        dwt_releaserxbuff().
+     *
+     * input parameters
+     * @param enable - 1 to defer the release to the application, 0 to release in dwt_isr (default)
+     *
+     * output parameters
+     *
+     * no return value
+     */
+    void dwt_setdblrxbuffdefer(int enable);
+
+    /*!
+     * ------------------------------------------------------------------------------------------------------------------
+     * @fn dwt_releaserxbuff()
+     *
+     * @brief Release the host side receive buffer held since the last RX good callback (see dwt_setdblrxbuffdefer)
+     *
+     * input parameters
+     *
+     * output parameters
+     *
+     * no return value
+     */
+    void dwt_releaserxbuff(void);
+
     /*!
      * ------------------------------------------------------------------------------------------------------------------
      * @fn dwt_setrxtimeout()
@@ -15,9 +15,113 @@
 #include "deca_device_api.h"
 #include "port.h"
 #include "stm32f4xx_hal_def.h"
+#include "cmsis_os2.h"
+#include <string.h>
 
 extern  SPI_HandleTypeDef hspi4;    /*clocked from 72MHz*/
 
+/* Bodies of at least this many bytes go through DMA, register accesses stay polled */
+#define DECA_SPI_DMA_MIN_LEN        32
+/* Thread flag used to wake the caller on DMA completion (above the UWB task event bits) */
+#define DECA_SPI_DMA_FLAG           0x00000100U
+#define DECA_SPI_DMA_TIMEOUT_MS     10
+
+static volatile osThreadId_t spi_dma_waiter = NULL;
+
+/****************************************************************************//**
+ *
+ *                              DW1000 SPI DMA section
+ *
+ *******************************************************************************/
+
+/* @fn      spi_dma_usable
+ * @brief   DMA only for long bodies outside CCM RAM (not reachable by DMA2), and only from a task
+ *          once the scheduler runs: the caller must be able to sleep. In ISR context (dwt_isr) the
+ *          HAL tick cannot preempt the DW1000 EXTI, so a DMA timeout could never fire there and
+ *          busy-waiting on DMA saves nothing over the polled transfer.
+ * */
+static int spi_dma_usable(const uint8_t *buf, uint32_t len)
+{
+    uint32_t addr = (uint32_t)buf;
+
+    return (len >= DECA_SPI_DMA_MIN_LEN) && (len <= 0xFFFFU) && ((addr & 0xFFFF0000U) != 0x10000000U) &&
+           (__get_IPSR() == 0U) && (osKernelGetState() == osKernelRunning);
+}
+
+/* @fn      spi_dma_prepare
+ * @brief   register the calling thread to be woken by the DMA completion callback
+ * */
+static void spi_dma_prepare(void)
+{
+    osThreadFlagsClear(DECA_SPI_DMA_FLAG);
+    spi_dma_waiter = osThreadGetId();
+}
+
+/* @fn      spi_dma_wait
+ * @brief   sleep until the DMA transfer started after spi_dma_prepare() completes
+ *          returns 0 for success, -1 on timeout (transfer aborted) or SPI error
+ * */
+static int spi_dma_wait(void)
+{
+    uint32_t flags = osThreadFlagsWait(DECA_SPI_DMA_FLAG, osFlagsWaitAny, DECA_SPI_DMA_TIMEOUT_MS);
+    spi_dma_waiter = NULL;
+
+    if (((flags & osFlagsError) != 0U) || (HAL_SPI_GetState(&hspi4) != HAL_SPI_STATE_READY))
+    {
+        HAL_SPI_Abort(&hspi4);
+        return -1;
+    }
+
+    return (hspi4.ErrorCode == HAL_SPI_ERROR_NONE) ? 0 : -1;
+}
+
+/* @fn      spi_restart_transaction
+ * @brief   after an aborted DMA body, toggle CS to end the partial transaction and resend the
+ *          header so the body can be transferred again in polling mode (DW1000 register reads and
+ *          writes are idempotent, so repeating the whole access is safe)
+ * */
+static void spi_restart_transaction(uint16_t headerLength, const uint8_t *headerBuffer)
+{
+    HAL_GPIO_WritePin(DW_NSS_GPIO_Port, DW_NSS_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(DW_NSS_GPIO_Port, DW_NSS_Pin, GPIO_PIN_RESET);
+    HAL_SPI_Transmit(&hspi4, (uint8_t *)&headerBuffer[0], headerLength, HAL_MAX_DELAY);
+}
+
+/* @fn      spi_dma_notify
+ * @brief   wake the waiting thread from the HAL SPI callbacks
+ * */
+static void spi_dma_notify(SPI_HandleTypeDef *hspi)
+{
+    osThreadId_t waiter = spi_dma_waiter;
+
+    if ((hspi == &hspi4) && (waiter != NULL))
+    {
+        osThreadFlagsSet(waiter, DECA_SPI_DMA_FLAG);
+    }
+}
+
+/* The CX310 adapter owns these callbacks in the CX310 build; the DW1000 library is only linked in the DW1000 build */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_dma_notify(hspi);
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_dma_notify(hspi);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_dma_notify(hspi);
+}
+
+/****************************************************************************//**
+ *
+ *                              END OF DW1000 SPI DMA section
+ *
+ *******************************************************************************/
+
 /****************************************************************************//**
  *
  *                              DW1000 SPI section
@@ -66,7 +170,30 @@ int writetospi(uint16_t headerLength,
     HAL_GPIO_WritePin(DW_NSS_GPIO_Port, DW_NSS_Pin, GPIO_PIN_RESET); /**< Put chip select line low */
 
     HAL_SPI_Transmit(&hspi4, (uint8_t *)&headerBuffer[0], headerLength, HAL_MAX_DELAY);    /* Send header in polling mode */
-    HAL_SPI_Transmit(&hspi4, (uint8_t *)&bodyBuffer[0], bodyLength, HAL_MAX_DELAY);        /* Send data in polling mode */
+
+    if (spi_dma_usable(bodyBuffer, bodyLength))
+    {
+        /* Send data by DMA, the caller sleeps until completion */
+        spi_dma_prepare();
+        if (HAL_SPI_Transmit_DMA(&hspi4, (uint8_t *)&bodyBuffer[0], (uint16_t)bodyLength) == HAL_OK)
+        {
+            if (spi_dma_wait() != 0)
+            {
+                /* DMA aborted part-way: the chip may have latched a truncated body, write it again */
+                spi_restart_transaction(headerLength, headerBuffer);
+                HAL_SPI_Transmit(&hspi4, (uint8_t *)&bodyBuffer[0], bodyLength, HAL_MAX_DELAY);
+            }
+        }
+        else
+        {
+            spi_dma_waiter = NULL;
+            HAL_SPI_Transmit(&hspi4, (uint8_t *)&bodyBuffer[0], bodyLength, HAL_MAX_DELAY);
+        }
+    }
+    else
+    {
+        HAL_SPI_Transmit(&hspi4, (uint8_t *)&bodyBuffer[0], bodyLength, HAL_MAX_DELAY);    /* Send data in polling mode */
+    }
 
     HAL_GPIO_WritePin(DW_NSS_GPIO_Port, DW_NSS_Pin, GPIO_PIN_SET); /**< Put chip select line high */
 
@@ -105,6 +232,30 @@ int readfromspi(uint16_t headerLength,
         HAL_SPI_Transmit(&hspi4, &headerBuffer[i], 1, HAL_MAX_DELAY); //No timeout
     }
 
+    /* Long bodies (e.g. dwt_readrxdata) by DMA: the buffer is zeroed and used as its own
+     * TX source, so MOSI stays 0 as in the polled path (TX always runs ahead of RX) */
+    if (spi_dma_usable(readBuffer, readlength))
+    {
+        memset(readBuffer, 0, readlength);
+        spi_dma_prepare();
+        if (HAL_SPI_TransmitReceive_DMA(&hspi4, readBuffer, readBuffer, (uint16_t)readlength) == HAL_OK)
+        {
+            if (spi_dma_wait() == 0)
+            {
+                readlength = 0;
+            }
+            else
+            {
+                /* DMA aborted part-way: the buffer holds a partial frame, read it again in polling mode */
+                spi_restart_transaction(headerLength, headerBuffer);
+            }
+        }
+        else
+        {
+            spi_dma_waiter = NULL;
+        }
+    }
+
     /* for the data buffer use LL functions directly as the HAL SPI read function
      * has issue reading single bytes */
     while(readlength-- > 0)
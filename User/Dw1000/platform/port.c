@@ -32,6 +32,9 @@ extern SPI_HandleTypeDef hspi4;
  *******************************************************************************/
 static volatile uint32_t signalResetDone;
 
+/* DW1000 IRQ handler definition. */
+port_deca_isr_t port_deca_isr = NULL;
+
 /****************************************************************************//**
  *
  *                              Time section
@@ -272,8 +275,8 @@ void port_wakeup_dw1000_fast(void)
 }
 
 /* @fn      port_set_dw1000_slowrate
- * @brief   set 2.25MHz
- *          note: hspi4 is clocked from 72MHz
+ * @brief   set ~703kHz, required before the DW1000 PLL locks
+ *          note: hspi4 is clocked from APB2 (90MHz)
  * */
 void port_set_dw1000_slowrate(void)
 {
@@ -282,8 +285,8 @@ void port_set_dw1000_slowrate(void)
 }
 
 /* @fn      port_set_dw1000_fastrate
- * @brief   set 18MHz
- *          note: hspi4 is clocked from 72MHz
+ * @brief   set ~1.4MHz (fixed default); uwb_task negotiates a faster rate via SpiSpeed_Negotiate
+ *          note: hspi4 is clocked from APB2 (90MHz)
  * */
 void port_set_dw1000_fastrate(void)
 {
@@ -305,25 +308,58 @@ void port_set_dw1000_fastrate(void)
  *
  *******************************************************************************/
 
-/* @fn      HAL_GPIO_EXTI_Callback
- * @brief   IRQ HAL call-back for all EXTI configured lines
- *          i.e. DW_RESET_Pin and DW_IRQn_Pin
+/* @fn      uwb_rdy_handler_wrapper
+ * @brief   EXTI call-back dispatched from Core/Src/gpio.c
+ *          On this board DW_IRQn shares PB7 with the CX310 RDY line.
  * */
-void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+void uwb_rdy_handler_wrapper(void)
 {
-    if (GPIO_Pin == DW_RESET_Pin)
-    {
-        signalResetDone = 1;
-    }
-    else if (GPIO_Pin == DW_IRQn_Pin)
+    process_deca_irq();
+}
+
+/* @fn      uwb_int_handler_wrapper
+ * @brief   PB6 (CX310 INT) is not connected on the DW1000 module
+ * */
+void uwb_int_handler_wrapper(void)
+{
+}
+
+/* @fn      port_set_deca_isr
+ * @brief   install the DW1000 IRQ handler, with the IRQ line masked
+ *          while the pointer is updated
+ * */
+void port_set_deca_isr(port_deca_isr_t deca_isr)
+{
+    /* Check DW1000 IRQ activation status. */
+    ITStatus en = port_GetEXT_IRQStatus();
+
+    /* If needed, deactivate DW1000 IRQ during the installation of the new handler. */
+    if (en)
     {
-        process_deca_irq();
+        port_DisableEXT_IRQ();
     }
-    else
+    port_deca_isr = deca_isr;
+    if (en)
     {
+        port_EnableEXT_IRQ();
     }
 }
 
+/* @fn      setup_DW1000IRQ
+ * @brief   DW1000 IRQ output is active high (HIRQ_POL default),
+ *          the CubeMX configuration of this pin is falling edge for CX310
+ * */
+void setup_DW1000IRQ(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+
+    GPIO_InitStruct.Pin = DECAIRQ;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+    GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(DECAIRQ_GPIO, &GPIO_InitStruct);
+}
+
 /* @fn      process_deca_irq
  * @brief   main call-back for processing of DW1000 IRQ
  *          it re-enters the IRQ routing and processes all events.
@@ -331,6 +367,11 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
  * */
 __INLINE void process_deca_irq(void)
 {
+    if (port_deca_isr == NULL)
+    {
+        return;
+    }
+
     while(port_CheckEXT_IRQ() != 0)
     {
 
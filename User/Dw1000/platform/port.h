@@ -178,6 +178,7 @@ extern "C"
     void spi_peripheral_init(void);
 
     void setup_DW1000RSTnIRQ(int enable);
+    void setup_DW1000IRQ(void);
 
     void reset_DW1000(void);
 
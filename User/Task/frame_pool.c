@@ -0,0 +1,95 @@
+#include "frame_pool.h"
+
+#include "cmsis_os2.h"
+#include "elog.h"
+
+static const char *TAG = "frame_pool";
+
+// 缓冲块存储区和空闲链表（空闲链表用消息队列实现，任务和中断中都可安全使用）
+static frame_buf_t pool_blocks[FRAME_POOL_BLOCK_COUNT];
+static osMessageQueueId_t pool_freeQueue = NULL;
+static volatile int pool_minFree = FRAME_POOL_BLOCK_COUNT;
+static volatile uint32_t pool_allocFails = 0;
+
+void FramePool_Init(void)
+{
+    if (pool_freeQueue != NULL)
+    {
+        return;
+    }
+
+    pool_freeQueue = osMessageQueueNew(FRAME_POOL_BLOCK_COUNT, sizeof(frame_buf_t *), NULL);
+    if (pool_freeQueue == NULL)
+    {
+        elog_e(TAG, "Failed to create frame pool free list");
+        return;
+    }
+
+    for (int i = 0; i < FRAME_POOL_BLOCK_COUNT; i++)
+    {
+        frame_buf_t *buf = &pool_blocks[i];
+        buf->refcnt = 0;
+        buf->len = 0;
+        osMessageQueuePut(pool_freeQueue, &buf, 0, 0);
+    }
+
+    elog_i(TAG, "Frame pool initialized: %d blocks x %d bytes", FRAME_POOL_BLOCK_COUNT, FRAME_POOL_BLOCK_SIZE);
+}
+
+frame_buf_t *FramePool_Alloc(uint32_t timeout_ms)
+{
+    frame_buf_t *buf = NULL;
+
+    if (pool_freeQueue == NULL || osMessageQueueGet(pool_freeQueue, &buf, NULL, timeout_ms) != osOK)
+    {
+        pool_allocFails++;
+        return NULL;
+    }
+
+    int free_count = (int)osMessageQueueGetCount(pool_freeQueue);
+    if (free_count < pool_minFree)
+    {
+        pool_minFree = free_count;
+    }
+
+    buf->refcnt = 1;
+    buf->len = 0;
+    return buf;
+}
+
+void FramePool_Retain(frame_buf_t *buf)
+{
+    if (buf == NULL)
+    {
+        return;
+    }
+    __atomic_add_fetch(&buf->refcnt, 1, __ATOMIC_RELAXED);
+}
+
+void FramePool_Release(frame_buf_t *buf)
+{
+    if (buf == NULL)
+    {
+        return;
+    }
+
+    if (__atomic_sub_fetch(&buf->refcnt, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        osMessageQueuePut(pool_freeQueue, &buf, 0, 0);
+    }
+}
+
+int FramePool_GetFreeCount(void)
+{
+    return pool_freeQueue ? (int)osMessageQueueGetCount(pool_freeQueue) : 0;
+}
+
+int FramePool_GetMinFreeCount(void)
+{
+    return pool_minFree;
+}
+
+uint32_t FramePool_GetAllocFailCount(void)
+{
+    return pool_allocFails;
+}
@@ -0,0 +1,47 @@
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define FRAME_POOL_BLOCK_SIZE 1016 // 单个缓冲块数据区大小，与FRAME_LEN_MAX一致
+#define FRAME_POOL_BLOCK_COUNT 32  // 缓冲块数量，UWB收发、UDP发送和可靠传输重传缓冲共享
+
+    // 固定大小的帧缓冲块
+    // 队列中只传递指针，数据只在写入芯片/从芯片读出时各拷贝一次
+    typedef struct
+    {
+        volatile uint8_t refcnt;             // 引用计数，为0时归还到空闲链表
+        uint8_t reserved;                    // 保留
+        uint16_t len;                        // data中有效数据长度
+        uint8_t data[FRAME_POOL_BLOCK_SIZE]; // 数据区
+    } frame_buf_t;
+
+    // 初始化缓冲池（在任何收发任务启动前调用，重复调用无副作用）
+    void FramePool_Init(void);
+
+    // 申请一个缓冲块，引用计数为1
+    // 参数：timeout_ms - 缓冲池耗尽时的等待时间（毫秒），中断中必须为0
+    // 返回：缓冲块指针，失败返回NULL
+    frame_buf_t *FramePool_Alloc(uint32_t timeout_ms);
+
+    // 增加引用计数（同一块数据被多个使用者持有时调用）
+    void FramePool_Retain(frame_buf_t *buf);
+
+    // 减少引用计数，为0时归还缓冲池；buf为NULL时忽略
+    void FramePool_Release(frame_buf_t *buf);
+
+    // API函数：获取缓冲池状态
+    int FramePool_GetFreeCount(void);           // 当前空闲块数量
+    int FramePool_GetMinFreeCount(void);        // 历史最少空闲块数量
+    uint32_t FramePool_GetAllocFailCount(void); // 申请失败次数
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FRAME_POOL_H */
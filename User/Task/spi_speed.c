@@ -0,0 +1,133 @@
+#include "spi_speed.h"
+
+#include "elog.h"
+#include "spi.h"
+
+static const char *TAG = "spi_speed";
+
+// 分频系数与HAL宏对应表，下标i对应 2^(i+1) 分频
+static const uint32_t spi_prescalers[] = {
+    SPI_BAUDRATEPRESCALER_2,  SPI_BAUDRATEPRESCALER_4,  SPI_BAUDRATEPRESCALER_8,   SPI_BAUDRATEPRESCALER_16,
+    SPI_BAUDRATEPRESCALER_32, SPI_BAUDRATEPRESCALER_64, SPI_BAUDRATEPRESCALER_128, SPI_BAUDRATEPRESCALER_256,
+};
+#define SPI_PRESCALER_NUM (sizeof(spi_prescalers) / sizeof(spi_prescalers[0]))
+
+static int spi_index_of(uint16_t div)
+{
+    for (int i = 0; i < (int)SPI_PRESCALER_NUM; i++)
+    {
+        if ((2U << i) == div)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static uint32_t spi_clock_of(int index)
+{
+    return HAL_RCC_GetPCLK2Freq() >> (index + 1);
+}
+
+static int spi_current_index(void)
+{
+    for (int i = 0; i < (int)SPI_PRESCALER_NUM; i++)
+    {
+        if (spi_prescalers[i] == hspi4.Init.BaudRatePrescaler)
+        {
+            return i;
+        }
+    }
+    return spi_index_of(SPI_SPEED_SLOW_DIV);
+}
+
+static int spi_apply_index(int index)
+{
+    if (hspi4.Init.BaudRatePrescaler == spi_prescalers[index])
+    {
+        return 0;
+    }
+
+    // 只改分频，DMA句柄和GPIO配置保持不变（HAL_SPI_Init在已初始化状态下不会重新调用MspInit）
+    hspi4.Init.BaudRatePrescaler = spi_prescalers[index];
+    return HAL_SPI_Init(&hspi4) == HAL_OK ? 0 : -1;
+}
+
+static int spi_verify_rounds(spi_speed_verify_fn_t verify, void *ctx)
+{
+    for (int i = 0; i < SPI_SPEED_VERIFY_ROUNDS; i++)
+    {
+        if (!verify(ctx))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void SpiSpeed_SetSlow(void)
+{
+    SpiSpeed_SetDivider(SPI_SPEED_SLOW_DIV);
+}
+
+int SpiSpeed_SetDivider(uint16_t div)
+{
+    int index = spi_index_of(div);
+    if (index < 0)
+    {
+        return -1;
+    }
+    return spi_apply_index(index);
+}
+
+uint32_t SpiSpeed_Negotiate(spi_speed_verify_fn_t verify, void *ctx, uint32_t max_hz)
+{
+    int best = spi_current_index();
+
+    if (verify == NULL)
+    {
+        return spi_clock_of(best);
+    }
+
+    if (!spi_verify_rounds(verify, ctx))
+    {
+        elog_w(TAG, "Readback failed at %lu Hz, staying slow", (unsigned long)spi_clock_of(best));
+        SpiSpeed_SetSlow();
+        return SpiSpeed_GetClockHz();
+    }
+
+    for (int i = best - 1; i >= 0; i--)
+    {
+        if (spi_clock_of(i) > max_hz)
+        {
+            break;
+        }
+        if (spi_apply_index(i) != 0 || !spi_verify_rounds(verify, ctx))
+        {
+            elog_w(TAG, "Readback failed at %lu Hz", (unsigned long)spi_clock_of(i));
+            break;
+        }
+        best = i;
+    }
+
+    // 回到最快的通过档位，并再次校验使芯片通信状态恢复同步
+    spi_apply_index(best);
+    if (!spi_verify_rounds(verify, ctx))
+    {
+        elog_w(TAG, "Readback unstable at %lu Hz, falling back to slow rate", (unsigned long)spi_clock_of(best));
+        SpiSpeed_SetSlow();
+    }
+
+    elog_i(TAG, "SPI4 clock: %lu Hz (div %u)", (unsigned long)SpiSpeed_GetClockHz(), SpiSpeed_GetDivider());
+    return SpiSpeed_GetClockHz();
+}
+
+uint32_t SpiSpeed_GetClockHz(void)
+{
+    return spi_clock_of(spi_current_index());
+}
+
+uint16_t SpiSpeed_GetDivider(void)
+{
+    return (uint16_t)(2U << spi_current_index());
+}
@@ -0,0 +1,39 @@
+#ifndef SPI_SPEED_H
+#define SPI_SPEED_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define SPI_SPEED_SLOW_DIV 64            // 复位/启动阶段使用的分频（APB2 90MHz / 64 ≈ 1.4MHz）
+#define SPI_SPEED_VERIFY_ROUNDS 8        // 每一档速率连续校验通过的次数
+#define SPI_SPEED_MAX_HZ_DW1000 20000000 // DW1000 SPI最高时钟（数据手册：PLL锁定后20MHz）
+#define SPI_SPEED_MAX_HZ_CX310 22500000  // CX310 SPI时钟上限，实际速率以校验结果为准
+
+    // 速率校验回调：在当前SPI速率下与芯片完成一次读回校验，通过返回非0
+    typedef int (*spi_speed_verify_fn_t)(void *ctx);
+
+    // 切换到复位/启动用的低速率（仅在UWB任务中、SPI空闲时调用）
+    void SpiSpeed_SetSlow(void);
+
+    // 按分频系数设置SPI4时钟，div为2~256的2的幂
+    // 返回：0 - 成功, -1 - 参数错误或初始化失败
+    int SpiSpeed_SetDivider(uint16_t div);
+
+    // 从当前速率开始逐档提速，直到校验失败或达到max_hz，最终停在最快的通过档位
+    // 当前速率本身校验失败时回到低速率
+    // 返回：最终的SPI时钟频率（Hz）
+    uint32_t SpiSpeed_Negotiate(spi_speed_verify_fn_t verify, void *ctx, uint32_t max_hz);
+
+    // API函数：获取当前SPI状态
+    uint32_t SpiSpeed_GetClockHz(void); // 当前SCK频率（Hz）
+    uint16_t SpiSpeed_GetDivider(void); // 当前分频系数
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPI_SPEED_H */
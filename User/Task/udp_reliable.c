@@ -0,0 +1,338 @@
+#include "udp_reliable.h"
+
+#include <string.h>
+
+#include "elog.h"
+
+static const char *TAG = "udp_rel";
+
+// 序号比较（允许回绕）
+#define SEQ_LT(a, b) ((int32_t)((a) - (b)) < 0)
+#define SEQ_LEQ(a, b) ((int32_t)((a) - (b)) <= 0)
+
+// 重传缓冲区槽位，序号seq存放在 slots[seq % UDP_REL_WINDOW]
+typedef struct
+{
+    frame_buf_t *buf;  // 未确认的数据，收到SACK或累计确认后释放
+    uint32_t sent_ms;  // 最近一次发送时刻
+    uint8_t retries;   // 重传次数，非0时不用于RTT采样（Karn算法）
+    uint8_t sacked;    // 已被SACK确认
+    uint8_t fast_retx; // 已快速重传过，避免同一个丢包反复快速重传
+} rel_slot_t;
+
+static struct
+{
+    udp_rel_output_t output;
+    uint8_t open;
+    uint32_t snd_una;  // 最早的未确认序号
+    uint32_t snd_nxt;  // 下一个新数据报的序号
+    uint32_t recover;  // 进入快速恢复时的snd_nxt，累计确认越过它之前不再减小窗口
+    uint16_t cwnd_x8;  // 拥塞窗口，1/8个数据报为单位
+    uint16_t ssthresh; // 慢启动阈值（数据报数）
+    uint16_t rwnd;     // 后端接收窗口（数据报数）
+    uint32_t srtt_ms;
+    uint32_t rttvar_ms;
+    uint32_t rto_ms;
+    rel_slot_t slots[UDP_REL_WINDOW];
+    udp_rel_stats_t stats;
+} rel;
+
+static rel_slot_t *rel_slot(uint32_t seq)
+{
+    return &rel.slots[seq % UDP_REL_WINDOW];
+}
+
+static void rel_release_all(void)
+{
+    for (int i = 0; i < UDP_REL_WINDOW; i++)
+    {
+        FramePool_Release(rel.slots[i].buf);
+    }
+    memset(rel.slots, 0, sizeof(rel.slots));
+}
+
+static void rel_reset(void)
+{
+    rel_release_all();
+    rel.snd_una = 0;
+    rel.snd_nxt = 0;
+    rel.recover = 0;
+    rel.cwnd_x8 = 2 * 8;
+    rel.ssthresh = UDP_REL_WINDOW;
+    rel.rwnd = UDP_REL_WINDOW;
+    rel.srtt_ms = 0;
+    rel.rttvar_ms = 0;
+    rel.rto_ms = UDP_REL_RTO_INIT_MS;
+}
+
+static uint16_t rel_inflight(void)
+{
+    return (uint16_t)(rel.snd_nxt - rel.snd_una);
+}
+
+// 有效窗口 = min(拥塞窗口, 接收窗口, 重传缓冲区)，至少为1，保证后端窗口更新丢失时仍能探测
+static uint16_t rel_window(void)
+{
+    uint16_t win = rel.cwnd_x8 / 8;
+    if (rel.rwnd < win)
+        win = rel.rwnd;
+    if (win > UDP_REL_WINDOW)
+        win = UDP_REL_WINDOW;
+    return win ? win : 1;
+}
+
+static void rel_rtt_sample(uint32_t rtt_ms)
+{
+    if (rel.srtt_ms == 0)
+    {
+        rel.srtt_ms = rtt_ms ? rtt_ms : 1;
+        rel.rttvar_ms = rtt_ms / 2;
+    }
+    else
+    {
+        uint32_t err = (rtt_ms > rel.srtt_ms) ? rtt_ms - rel.srtt_ms : rel.srtt_ms - rtt_ms;
+        rel.rttvar_ms = (3 * rel.rttvar_ms + err) / 4;
+        rel.srtt_ms = (7 * rel.srtt_ms + rtt_ms) / 8;
+    }
+
+    rel.rto_ms = rel.srtt_ms + 4 * rel.rttvar_ms;
+    if (rel.rto_ms < UDP_REL_RTO_MIN_MS)
+        rel.rto_ms = UDP_REL_RTO_MIN_MS;
+    if (rel.rto_ms > UDP_REL_RTO_MAX_MS)
+        rel.rto_ms = UDP_REL_RTO_MAX_MS;
+}
+
+// 每确认一个数据报：慢启动阶段窗口加1，拥塞避免阶段每个窗口加1
+static void rel_grow_cwnd(void)
+{
+    if (rel.cwnd_x8 < rel.ssthresh * 8)
+    {
+        rel.cwnd_x8 += 8;
+    }
+    else
+    {
+        uint16_t inc = 64 / rel.cwnd_x8;
+        rel.cwnd_x8 += inc ? inc : 1;
+    }
+
+    if (rel.cwnd_x8 > UDP_REL_WINDOW * 8)
+        rel.cwnd_x8 = UDP_REL_WINDOW * 8;
+}
+
+static void rel_retransmit(uint32_t seq, rel_slot_t *slot, uint32_t now_ms)
+{
+    slot->retries++;
+    slot->sent_ms = now_ms;
+    rel.stats.retransmits++;
+    rel.output(slot->buf, seq);
+}
+
+void UdpRel_Init(udp_rel_output_t output)
+{
+    memset(&rel, 0, sizeof(rel));
+    rel.output = output;
+    rel_reset();
+}
+
+void UdpRel_Open(void)
+{
+    rel_reset();
+    rel.open = 1;
+    elog_i(TAG, "Reliable uplink opened");
+}
+
+void UdpRel_Close(void)
+{
+    if (rel.open)
+    {
+        elog_i(TAG, "Reliable uplink closed: sent=%lu acked=%lu retx=%lu timeouts=%lu", rel.stats.sent,
+               rel.stats.acked, rel.stats.retransmits, rel.stats.timeouts);
+    }
+    rel_reset();
+    rel.open = 0;
+}
+
+int UdpRel_IsOpen(void)
+{
+    return rel.open;
+}
+
+int UdpRel_CanSend(void)
+{
+    return rel.open && rel_inflight() < rel_window();
+}
+
+void UdpRel_Send(frame_buf_t *buf, uint32_t now_ms)
+{
+    uint32_t seq = rel.snd_nxt++;
+    rel_slot_t *slot = rel_slot(seq);
+
+    slot->buf = buf;
+    slot->sent_ms = now_ms;
+    slot->retries = 0;
+    slot->sacked = 0;
+    slot->fast_retx = 0;
+
+    rel.stats.sent++;
+    rel.output(buf, seq);
+}
+
+void UdpRel_OnAck(uint32_t cum_ack, uint32_t sack, uint16_t rwnd, uint32_t now_ms)
+{
+    if (!rel.open || SEQ_LT(rel.snd_nxt, cum_ack))
+    {
+        return; // 未开启或确认了尚未发送的序号
+    }
+    if (SEQ_LT(cum_ack, rel.snd_una))
+    {
+        // 迟到或乱序的旧ACK：其SACK位按旧的cum_ack计算，映射到槽位会落在更新的在途数据报上，接收窗口也已过时
+        return;
+    }
+
+    rel.rwnd = rwnd;
+
+    // 累计确认
+    while (SEQ_LT(rel.snd_una, cum_ack))
+    {
+        rel_slot_t *slot = rel_slot(rel.snd_una);
+        if (!slot->sacked)
+        {
+            if (slot->retries == 0)
+            {
+                rel_rtt_sample(now_ms - slot->sent_ms);
+            }
+            rel.stats.acked++;
+            rel_grow_cwnd();
+        }
+        FramePool_Release(slot->buf);
+        memset(slot, 0, sizeof(*slot));
+        rel.snd_una++;
+    }
+
+    // 选择确认：后端已收到的乱序数据报可以提前释放缓冲块
+    uint32_t highest_sacked = rel.snd_una;
+    int has_sack = 0;
+    for (int i = 0; i < 32; i++)
+    {
+        uint32_t seq = cum_ack + 1 + i;
+        if (!SEQ_LT(seq, rel.snd_nxt))
+            break;
+        if (!(sack & (1UL << i)))
+            continue;
+
+        rel_slot_t *slot = rel_slot(seq);
+        if (!slot->sacked)
+        {
+            slot->sacked = 1;
+            FramePool_Release(slot->buf);
+            slot->buf = NULL;
+            rel.stats.acked++;
+            rel_grow_cwnd();
+        }
+        highest_sacked = seq;
+        has_sack = 1;
+    }
+
+    if (!has_sack)
+    {
+        return;
+    }
+
+    // 快速重传：之后已有UDP_REL_DUP_THRESH个数据报到达的空洞判定为丢失
+    for (uint32_t seq = rel.snd_una; SEQ_LT(seq, highest_sacked); seq++)
+    {
+        rel_slot_t *slot = rel_slot(seq);
+        if (slot->sacked || slot->fast_retx)
+            continue;
+
+        uint8_t later = 0;
+        for (uint32_t s = seq + 1; SEQ_LEQ(s, highest_sacked); s++)
+        {
+            if (rel_slot(s)->sacked)
+                later++;
+        }
+        if (later < UDP_REL_DUP_THRESH)
+            continue;
+
+        // 每个丢包窗口只减小一次拥塞窗口
+        if (!SEQ_LT(seq, rel.recover))
+        {
+            uint16_t half = rel_inflight() / 2;
+            rel.ssthresh = half > 2 ? half : 2;
+            rel.cwnd_x8 = rel.ssthresh * 8;
+            rel.recover = rel.snd_nxt;
+        }
+
+        slot->fast_retx = 1;
+        rel_retransmit(seq, slot, now_ms);
+    }
+}
+
+uint32_t UdpRel_Poll(uint32_t now_ms)
+{
+    if (!rel.open || rel_inflight() == 0)
+    {
+        return UDP_REL_NO_TIMER;
+    }
+
+    uint32_t next = UDP_REL_NO_TIMER;
+    int timed_out = 0;
+
+    for (uint32_t seq = rel.snd_una; SEQ_LT(seq, rel.snd_nxt); seq++)
+    {
+        rel_slot_t *slot = rel_slot(seq);
+        if (slot->sacked)
+            continue;
+
+        uint32_t elapsed = now_ms - slot->sent_ms;
+        if (elapsed < rel.rto_ms)
+        {
+            uint32_t remain = rel.rto_ms - elapsed;
+            if (remain < next)
+                next = remain;
+            continue;
+        }
+
+        if (slot->retries >= UDP_REL_MAX_RETRIES)
+        {
+            // 后端长时间没有确认，放弃可靠传输，之后的数据按普通UDP发送
+            elog_w(TAG, "Seq %lu not acknowledged after %d retries, closing reliable uplink", seq, slot->retries);
+            rel.stats.aborts++;
+            UdpRel_Close();
+            return UDP_REL_NO_TIMER;
+        }
+
+        // 超时：窗口回到1并指数退避，本轮只处理一次
+        if (!timed_out)
+        {
+            uint16_t half = rel_inflight() / 2;
+            rel.ssthresh = half > 2 ? half : 2;
+            rel.cwnd_x8 = 8;
+            rel.recover = rel.snd_nxt;
+            rel.rto_ms = (rel.rto_ms * 2 < UDP_REL_RTO_MAX_MS) ? rel.rto_ms * 2 : UDP_REL_RTO_MAX_MS;
+            rel.stats.timeouts++;
+            timed_out = 1;
+        }
+
+        slot->fast_retx = 0;
+        rel_retransmit(seq, slot, now_ms);
+        if (rel.rto_ms < next)
+            next = rel.rto_ms;
+    }
+
+    return next;
+}
+
+void UdpRel_GetStats(udp_rel_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    *stats = rel.stats;
+    stats->inflight = rel_inflight();
+    stats->cwnd = rel.cwnd_x8 / 8;
+    stats->srtt_ms = rel.srtt_ms;
+    stats->rto_ms = rel.rto_ms;
+}
@@ -0,0 +1,87 @@
+#ifndef UDP_RELIABLE_H
+#define UDP_RELIABLE_H
+
+#include "frame_pool.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 可靠上行传输：在UDP之上为Slave2Backend批量数据提供序号、选择确认(SACK)、有界重传缓冲和拥塞窗口
+// 由后端发送OPEN数据报开启，未开启时数据仍按普通UDP发送。本模块只维护发送状态，全部接口只在UDP任务中调用。
+
+#define UDP_REL_MAGIC_1 0xAB          // 传输层数据报首字节（与协议帧帧头0xAB 0xCD区分）
+#define UDP_REL_MAGIC_2 0xCE          // 传输层数据报第二字节
+#define UDP_REL_HEADER_LEN 8          // 数据报头：magic(2) + type(1) + flags(1) + seq(4)
+#define UDP_REL_ACK_LEN 14            // ACK数据报：数据报头 + sack(4) + rwnd(2)，头中seq为累计确认序号
+#define UDP_REL_WINDOW 8              // 最大在途数据报数，即重传缓冲区大小（占用帧缓冲池）
+#define UDP_REL_QUEUE_SIZE 4          // 等待进入窗口的数据报数
+#define UDP_REL_RTO_INIT_MS 200       // 初始重传超时 (ms)
+#define UDP_REL_RTO_MIN_MS 20         // 重传超时下限 (ms)
+#define UDP_REL_RTO_MAX_MS 2000       // 重传超时上限 (ms)
+#define UDP_REL_MAX_RETRIES 8         // 单个数据报最多重传次数，超过后关闭可靠传输
+#define UDP_REL_DUP_THRESH 3          // SACK显示之后已有多少个数据报到达时判定丢失并快速重传
+#define UDP_REL_NO_TIMER 0xFFFFFFFFU  // UdpRel_Poll返回值：没有待处理的定时器
+
+    // 传输层数据报类型
+    typedef enum
+    {
+        UDP_REL_TYPE_DATA = 1,  // 主机->后端：数据
+        UDP_REL_TYPE_ACK = 2,   // 后端->主机：累计确认 + SACK + 接收窗口
+        UDP_REL_TYPE_OPEN = 3,  // 后端->主机：开启并复位可靠传输，主机原样回复
+        UDP_REL_TYPE_CLOSE = 4, // 后端->主机：关闭可靠传输
+    } udp_rel_type_t;
+
+    // 发送回调：把缓冲块以指定序号发送一次（回调自行增加引用，本模块继续持有缓冲块直到确认）
+    typedef void (*udp_rel_output_t)(frame_buf_t *buf, uint32_t seq);
+
+    // 可靠传输统计
+    typedef struct
+    {
+        uint32_t sent;        // 首次发送的数据报数
+        uint32_t acked;       // 已确认的数据报数
+        uint32_t retransmits; // 重传次数（含快速重传）
+        uint32_t timeouts;    // 重传超时次数
+        uint32_t aborts;      // 重传次数耗尽导致关闭的次数
+        uint16_t inflight;    // 当前在途数据报数
+        uint16_t cwnd;        // 当前拥塞窗口（数据报数）
+        uint32_t srtt_ms;     // 平滑RTT (ms)
+        uint32_t rto_ms;      // 当前重传超时 (ms)
+    } udp_rel_stats_t;
+
+    // 初始化（关闭状态）
+    void UdpRel_Init(udp_rel_output_t output);
+
+    // 开启并复位：释放在途数据，序号从0开始
+    void UdpRel_Open(void);
+
+    // 关闭：释放在途数据，之后的数据按普通UDP发送
+    void UdpRel_Close(void);
+
+    // 是否已开启
+    int UdpRel_IsOpen(void);
+
+    // 窗口是否允许再发送一个新数据报
+    int UdpRel_CanSend(void);
+
+    // 发送新数据报，接管buf的一个引用（调用前须确认UdpRel_CanSend）
+    void UdpRel_Send(frame_buf_t *buf, uint32_t now_ms);
+
+    // 处理ACK
+    // 参数：cum_ack - 后端期望的下一个序号, sack - 第i位表示cum_ack+1+i已收到, rwnd - 后端可接收的数据报数
+    void UdpRel_OnAck(uint32_t cum_ack, uint32_t sack, uint16_t rwnd, uint32_t now_ms);
+
+    // 处理重传超时
+    // 返回：距离下一次超时的时间 (ms)，没有在途数据时返回UDP_REL_NO_TIMER
+    uint32_t UdpRel_Poll(uint32_t now_ms);
+
+    // 获取可靠传输统计（UDP任务每REL_STATS_LOG_INTERVAL_MS输出一次到日志）
+    void UdpRel_GetStats(udp_rel_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDP_RELIABLE_H */
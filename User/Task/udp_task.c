@@ -5,15 +5,29 @@
 
 
 #include "cmsis_os.h"
+#include "lwip/api.h"
 #include "lwip/inet.h"
+#include "lwip/memp.h"
 #include "lwip/netdb.h"
 #include "lwip/sockets.h"
 #include "main.h"
+#include "udp_reliable.h"
 #include "udp_task.h"
 
 #define UDP_SERVER_PORT 8080
 #define TX_QUEUE_SIZE 10
-#define RX_QUEUE_SIZE 10
+#define RX_QUEUE_SIZE 4 // 接收队列深度
+// 接收队列中最多允许几条消息直接引用以太网接收缓冲区（ETH_RX_BUFFER_CNT=12）。
+// 加上netconn接收邮箱（DEFAULT_UDP_RECVMBOX_SIZE=6）和消费者正在解析的一条，仍给ARP/ICMP留出缓冲区；
+// 超出部分拷贝到PBUF_RAM后立即归还以太网缓冲区
+#define RX_ZEROCOPY_MAX 2
+#define TX_ENQUEUE_TIMEOUT_MS 100       // 普通发送入队等待时间 (ms)
+#define REL_ENQUEUE_TIMEOUT_MS 0        // 可靠上行入队不等待，队列满时丢弃并计数，不阻塞SlaveDataProcT
+#define REL_STATS_LOG_INTERVAL_MS 10000 // 可靠传输统计日志间隔 (ms)，期间没有变化时不输出
+
+// UDP任务唤醒标志
+#define UDP_FLAG_RX 0x01U // 协议栈收到数据报
+#define UDP_FLAG_TX 0x02U // 发送队列有新消息
 
 // 消息类型定义
 typedef enum
@@ -23,165 +37,407 @@ typedef enum
     MSG_TYPE_CONFIG         // 配置信息
 } msg_type_t;
 
-// 发送消息结构体
+// 发送消息结构体（只传递缓冲块指针，数据不经过队列拷贝）
 typedef struct
 {
     msg_type_t type;
-    struct sockaddr_in dest_addr; // 目标地址
-    uint16_t data_len;
-    uint8_t data[UDP_BUFFER_SIZE];
+    ip_addr_t dest_ip;  // 目标地址
+    uint16_t dest_port; // 目标端口
+    frame_buf_t *buf;   // 待发送数据，持有一个引用
 } tx_msg_t;
 
+// 引用缓冲块的自定义pbuf：以太网DMA发送完成、协议栈释放pbuf时归还缓冲块
+typedef struct
+{
+    struct pbuf_custom pc;
+    frame_buf_t *buf;
+} udp_tx_pbuf_t;
+
+// 在途的发送pbuf数量不会超过发送队列深度加可靠传输窗口
+LWIP_MEMPOOL_DECLARE(UDP_TX_PBUF, TX_QUEUE_SIZE + UDP_REL_WINDOW, sizeof(udp_tx_pbuf_t), "Zero-copy UDP TX PBUF pool");
+
 // 全局变量
-static osMessageQueueId_t txQueue; // 发送队列
-static osMessageQueueId_t rxQueue; // 接收队列
+static osMessageQueueId_t txQueue;  // 发送队列
+static osMessageQueueId_t relQueue; // 可靠上行数据等待进入窗口的队列
+static osMessageQueueId_t rxQueue;  // 接收队列
 static osThreadId_t udpTaskHandle;
 
+// 可靠上行数据的连接和目标地址（仅UDP任务访问）
+static struct netconn *rel_conn;
+static ip_addr_t rel_dest_ip;
+static uint16_t rel_dest_port;
+static uint32_t rel_stats_log_ms;
+
+// 可靠上行入队失败（队列满）丢弃的数据报数，只由调用UDP_SendReliable的任务累加
+static volatile uint32_t rel_queue_drops;
+
 // 接收数据回调函数指针
 typedef void (*udp_rx_callback_t)(const udp_rx_msg_t *msg);
 static udp_rx_callback_t rx_callback = NULL;
 
-// UDP通信任务
-void udp_comm_task(void *argument)
+// lwIP错误码描述
+static const char *udp_err_desc(err_t err)
+{
+    switch (err)
+    {
+    case ERR_MEM:
+    case ERR_BUF:
+        return "No buffer space available";
+    case ERR_RTE:
+        return "Network unreachable";
+    case ERR_IF:
+        return "Network is down";
+    case ERR_VAL:
+    case ERR_ARG:
+        return "Invalid argument";
+    default:
+        return "Socket send error";
+    }
+}
+
+// netconn事件回调（在tcpip线程中执行）：收到数据报时唤醒UDP任务
+static void udp_netconn_event(struct netconn *conn, enum netconn_evt evt, u16_t len)
+{
+    (void)conn;
+    (void)len;
+    if (evt == NETCONN_EVT_RCVPLUS && udpTaskHandle != NULL)
+    {
+        osThreadFlagsSet(udpTaskHandle, UDP_FLAG_RX);
+    }
+}
+
+// 发送pbuf释放回调：以太网驱动在DMA发送完成后释放pbuf链，此时缓冲块才可以复用
+static void udp_tx_pbuf_free(struct pbuf *p)
+{
+    udp_tx_pbuf_t *tx_pbuf = (udp_tx_pbuf_t *)p;
+    FramePool_Release(tx_pbuf->buf);
+    LWIP_MEMPOOL_FREE(UDP_TX_PBUF, tx_pbuf);
+}
+
+// 把缓冲块包装成PBUF_REF类型的pbuf，接管buf的一个引用（失败时释放该引用）
+// 缓冲块直接交给以太网DMA，不再拷贝；ethernetif在发送完成前一直持有pbuf，所以缓冲块的归还交给pbuf释放回调
+static struct pbuf *udp_buf_pbuf(frame_buf_t *buf)
+{
+    udp_tx_pbuf_t *tx_pbuf = (udp_tx_pbuf_t *)LWIP_MEMPOOL_ALLOC(UDP_TX_PBUF);
+    if (tx_pbuf == NULL)
+    {
+        FramePool_Release(buf);
+        return NULL;
+    }
+    tx_pbuf->pc.custom_free_function = udp_tx_pbuf_free;
+    tx_pbuf->buf = buf;
+
+    return pbuf_alloced_custom(PBUF_RAW, buf->len, PBUF_REF, &tx_pbuf->pc, buf->data, FRAME_POOL_BLOCK_SIZE);
+}
+
+// 发送pbuf链，无论成功与否都释放调用者持有的p
+static err_t udp_send_pbuf(struct netconn *conn, struct pbuf *p, const ip_addr_t *ip, uint16_t port)
+{
+    // 与lwip_sendto一样使用栈上的netbuf，不占用MEMP_NETBUF池（默认只有2个）
+    struct netbuf nb;
+    memset(&nb, 0, sizeof(nb));
+    nb.p = p;
+    nb.ptr = p;
+
+    // netconn_sendto不接管pbuf，协议栈需要时自行增加引用；发送返回后释放本任务持有的引用
+    err_t err = netconn_sendto(conn, &nb, ip, port);
+    pbuf_free(p);
+    return err;
+}
+
+// 发送一条消息
+static void udp_send_msg(struct netconn *conn, const tx_msg_t *tx_msg)
+{
+    uint16_t len = tx_msg->buf->len;
+
+    struct pbuf *p = udp_buf_pbuf(tx_msg->buf);
+    err_t err = (p != NULL) ? udp_send_pbuf(conn, p, &tx_msg->dest_ip, tx_msg->dest_port) : ERR_MEM;
+
+    if (err != ERR_OK)
+    {
+        elog_e("udp_task", "UDP sendto failed: %s, target=%s:%d, size=%d", udp_err_desc(err),
+               ipaddr_ntoa(&tx_msg->dest_ip), tx_msg->dest_port, len);
+    }
+    else
+    {
+        elog_v("udp_task", "UDP sent %d bytes to %s:%d", len, ipaddr_ntoa(&tx_msg->dest_ip), tx_msg->dest_port);
+    }
+}
+
+// 可靠传输发送回调：在缓冲块前加上序号头发送一次，本模块继续持有原引用用于重传
+static void udp_rel_output(frame_buf_t *buf, uint32_t seq)
+{
+    FramePool_Retain(buf);
+    struct pbuf *data = udp_buf_pbuf(buf);
+    if (data == NULL)
+    {
+        return; // 由重传超时补发
+    }
+
+    // 头部单独分配并预留UDP/IP头空间，数据部分仍然零拷贝
+    struct pbuf *hdr = pbuf_alloc(PBUF_TRANSPORT, UDP_REL_HEADER_LEN, PBUF_RAM);
+    if (hdr == NULL)
+    {
+        pbuf_free(data);
+        return;
+    }
+
+    uint8_t *h = (uint8_t *)hdr->payload;
+    h[0] = UDP_REL_MAGIC_1;
+    h[1] = UDP_REL_MAGIC_2;
+    h[2] = UDP_REL_TYPE_DATA;
+    h[3] = 0;
+    h[4] = seq & 0xFF;
+    h[5] = (seq >> 8) & 0xFF;
+    h[6] = (seq >> 16) & 0xFF;
+    h[7] = (seq >> 24) & 0xFF;
+    pbuf_cat(hdr, data);
+
+    err_t err = udp_send_pbuf(rel_conn, hdr, &rel_dest_ip, rel_dest_port);
+    if (err != ERR_OK)
+    {
+        elog_w("udp_task", "Reliable seq %lu send failed: %s", seq, udp_err_desc(err));
+    }
+}
+
+// 处理后端发来的传输层数据报（ACK/OPEN/CLOSE）
+static void udp_handle_transport(struct netconn *conn, struct pbuf *p, const ip_addr_t *from_ip, uint16_t from_port)
+{
+    uint8_t h[UDP_REL_ACK_LEN];
+    uint16_t n = pbuf_copy_partial(p, h, sizeof(h), 0);
+    if (n < UDP_REL_HEADER_LEN)
+    {
+        return;
+    }
+
+    uint32_t seq = h[4] | (h[5] << 8) | (h[6] << 16) | ((uint32_t)h[7] << 24);
+    switch (h[2])
+    {
+    case UDP_REL_TYPE_ACK:
+        if (n >= UDP_REL_ACK_LEN)
+        {
+            uint32_t sack = h[8] | (h[9] << 8) | (h[10] << 16) | ((uint32_t)h[11] << 24);
+            uint16_t rwnd = h[12] | (h[13] << 8);
+            UdpRel_OnAck(seq, sack, rwnd, osKernelGetTickCount());
+        }
+        break;
+
+    case UDP_REL_TYPE_OPEN: {
+        UdpRel_Open();
+
+        // 原样回复OPEN，后端据此确认主机已复位序号
+        struct pbuf *reply = pbuf_alloc(PBUF_TRANSPORT, UDP_REL_HEADER_LEN, PBUF_RAM);
+        if (reply != NULL)
+        {
+            memcpy(reply->payload, h, UDP_REL_HEADER_LEN);
+            udp_send_pbuf(conn, reply, from_ip, from_port);
+        }
+        break;
+    }
+
+    case UDP_REL_TYPE_CLOSE:
+        UdpRel_Close();
+        break;
+
+    default:
+        break;
+    }
+}
+
+// 把等待中的可靠上行数据送入窗口；可靠传输未开启时按普通UDP发送
+static void udp_drain_reliable(struct netconn *conn)
 {
-    int sockfd;
-    struct sockaddr_in server_addr, client_addr;
-    char buffer[UDP_BUFFER_SIZE];
-    socklen_t client_addr_len = sizeof(client_addr);
-    int recv_len;
     tx_msg_t tx_msg;
+    while (!UdpRel_IsOpen() || UdpRel_CanSend())
+    {
+        if (osMessageQueueGet(relQueue, &tx_msg, NULL, 0) != osOK)
+        {
+            break;
+        }
+
+        if (!UdpRel_IsOpen())
+        {
+            udp_send_msg(conn, &tx_msg);
+            continue;
+        }
+
+        rel_dest_ip = tx_msg.dest_ip;
+        rel_dest_port = tx_msg.dest_port;
+        UdpRel_Send(tx_msg.buf, osKernelGetTickCount());
+    }
+}
+
+// 取出发送队列中的全部消息
+static void udp_drain_tx(struct netconn *conn)
+{
+    tx_msg_t tx_msg;
+    while (osMessageQueueGet(txQueue, &tx_msg, NULL, 0) == osOK)
+    {
+        switch (tx_msg.type)
+        {
+        case MSG_TYPE_SEND_DATA:
+            udp_send_msg(conn, &tx_msg);
+            break;
+
+        case MSG_TYPE_CLOSE_CONN:
+        case MSG_TYPE_CONFIG:
+        default:
+            FramePool_Release(tx_msg.buf);
+            break;
+        }
+    }
+}
+
+// 取出协议栈中已到达的全部数据报
+// 通常只把pbuf链的所有权转交给接收队列，数据留在以太网接收缓冲区中，由消费者解析后释放
+static void udp_drain_rx(struct netconn *conn)
+{
     udp_rx_msg_t rx_msg;
+    struct netbuf *nb;
 
-    // 创建 socket
-    sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sockfd < 0)
+    while (netconn_recv_udp_raw_netbuf_flags(conn, &nb, NETCONN_DONTBLOCK) == ERR_OK)
+    {
+        // 传输层数据报由本任务处理，不交给应用
+        struct pbuf *p = nb->p;
+        if (p->len >= 2 && ((uint8_t *)p->payload)[0] == UDP_REL_MAGIC_1 &&
+            ((uint8_t *)p->payload)[1] == UDP_REL_MAGIC_2)
+        {
+            udp_handle_transport(conn, p, netbuf_fromaddr(nb), netbuf_fromport(nb));
+            netbuf_delete(nb);
+            continue;
+        }
+
+        // 构造接收消息，从netbuf中取走pbuf链后只释放netbuf本身
+        memset(&rx_msg.src_addr, 0, sizeof(rx_msg.src_addr));
+        rx_msg.src_addr.sin_family = AF_INET;
+        rx_msg.src_addr.sin_port = htons(netbuf_fromport(nb));
+        inet_addr_from_ip4addr(&rx_msg.src_addr.sin_addr, ip_2_ip4(netbuf_fromaddr(nb)));
+        rx_msg.p = nb->p;
+        rx_msg.data_len = nb->p->tot_len;
+        nb->p = NULL;
+        nb->ptr = NULL;
+        netbuf_delete(nb);
+
+        // 队列中已有较多消息占用以太网缓冲区，或数据报跨多个缓冲区（IP分片）时拷贝出来，避免接收缓冲池被占满
+        if (osMessageQueueGetCount(rxQueue) >= RX_ZEROCOPY_MAX || rx_msg.p->next != NULL)
+        {
+            struct pbuf *copy = pbuf_clone(PBUF_RAW, PBUF_RAM, rx_msg.p);
+            if (copy != NULL)
+            {
+                pbuf_free(rx_msg.p);
+                rx_msg.p = copy;
+            }
+        }
+
+        // 如果有回调函数，调用它
+        if (rx_callback != NULL)
+        {
+            rx_callback(&rx_msg);
+        }
+
+        // 将数据放入接收队列
+        if (osMessageQueuePut(rxQueue, &rx_msg, 0, 0) != osOK)
+        {
+            elog_w("udp_task", "UDP RX queue full, dropping packet from %s:%d (%d bytes)",
+                   inet_ntoa(rx_msg.src_addr.sin_addr), ntohs(rx_msg.src_addr.sin_port), rx_msg.data_len);
+            pbuf_free(rx_msg.p);
+        }
+        else
+        {
+            elog_v("udp_task", "UDP received %d bytes from %s:%d", rx_msg.data_len, inet_ntoa(rx_msg.src_addr.sin_addr),
+                   ntohs(rx_msg.src_addr.sin_port));
+        }
+    }
+}
+
+// 定期输出可靠传输统计，返回距离下一次输出的时间 (ms)
+static uint32_t udp_rel_log_stats(uint32_t now_ms)
+{
+    static udp_rel_stats_t last;
+    static uint32_t last_drops;
+
+    uint32_t elapsed = now_ms - rel_stats_log_ms;
+    if (elapsed < REL_STATS_LOG_INTERVAL_MS)
+    {
+        return REL_STATS_LOG_INTERVAL_MS - elapsed;
+    }
+    rel_stats_log_ms = now_ms;
+
+    udp_rel_stats_t stats;
+    UdpRel_GetStats(&stats);
+    uint32_t drops = rel_queue_drops;
+    if (stats.sent != last.sent || stats.retransmits != last.retransmits || stats.aborts != last.aborts ||
+        drops != last_drops)
+    {
+        elog_i("udp_task",
+               "Reliable uplink %s: sent=%lu acked=%lu retx=%lu timeouts=%lu aborts=%lu drops=%lu inflight=%d cwnd=%d "
+               "srtt=%lums rto=%lums",
+               UdpRel_IsOpen() ? "open" : "closed", stats.sent, stats.acked, stats.retransmits, stats.timeouts,
+               stats.aborts, drops, stats.inflight, stats.cwnd, stats.srtt_ms, stats.rto_ms);
+        last = stats;
+        last_drops = drops;
+    }
+    return REL_STATS_LOG_INTERVAL_MS;
+}
+
+// UDP通信任务
+// 阻塞等待"收到数据报"或"发送队列有数据"通知，每次唤醒后把两个方向上积压的数据全部处理完
+void udp_comm_task(void *argument)
+{
+    struct netconn *conn;
+
+    LWIP_MEMPOOL_INIT(UDP_TX_PBUF);
+    UdpRel_Init(udp_rel_output);
+
+    // 创建 netconn，数据到达时由回调唤醒本任务
+    conn = netconn_new_with_callback(NETCONN_UDP, udp_netconn_event);
+    if (conn == NULL)
     {
         elog_e("udp_task", "Failed to create UDP socket");
         osThreadExit();
     }
 
-    // 设置服务器地址结构
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(UDP_SERVER_PORT);
-    server_addr.sin_addr.s_addr = htonl(INADDR_ANY);
-
-    // 绑定 socket
-    if (bind(sockfd, (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0)
+    // 绑定端口
+    if (netconn_bind(conn, IP_ADDR_ANY, UDP_SERVER_PORT) != ERR_OK)
     {
         elog_e("udp_task", "Failed to bind UDP socket to port %d", UDP_SERVER_PORT);
-        closesocket(sockfd);
+        netconn_delete(conn);
         osThreadExit();
     }
 
+    rel_conn = conn;
+    rel_stats_log_ms = osKernelGetTickCount();
     elog_i("udp_task", "UDP server started on port %d", UDP_SERVER_PORT);
 
     while (1)
     {
-        // 检查是否有发送消息
-        if (osMessageQueueGet(txQueue, &tx_msg, NULL, 0) == osOK)
+        udp_drain_rx(conn);
+        udp_drain_tx(conn);
+        udp_drain_reliable(conn);
+
+        // 处理可靠传输的重传超时；因重传耗尽而关闭时，立即把排队的数据按普通UDP发出
+        uint32_t now = osKernelGetTickCount();
+        uint32_t wait_ms = UdpRel_Poll(now);
+        if (!UdpRel_IsOpen() && osMessageQueueGetCount(relQueue) > 0)
         {
-            switch (tx_msg.type)
-            {
-            case MSG_TYPE_SEND_DATA:
-                // 发送数据到指定地址
-                {
-                    int sent_bytes = sendto(sockfd, tx_msg.data, tx_msg.data_len, 0,
-                                            (struct sockaddr *)&tx_msg.dest_addr, sizeof(tx_msg.dest_addr));
-                    if (sent_bytes < 0)
-                    {
-                        // 发送失败，记录错误
-                        const char *error_desc = "Unknown error";
-                        switch (errno)
-                        {
-                        case ENOBUFS:
-                            error_desc = "No buffer space available";
-                            break;
-                        case ENETDOWN:
-                            error_desc = "Network is down";
-                            break;
-                        case ENETUNREACH:
-                            error_desc = "Network unreachable";
-                            break;
-                        case EHOSTUNREACH:
-                            error_desc = "Host unreachable";
-                            break;
-                        case ECONNREFUSED:
-                            error_desc = "Connection refused";
-                            break;
-                        case EMSGSIZE:
-                            error_desc = "Message too large";
-                            break;
-                        default:
-                            error_desc = "Socket send error";
-                            break;
-                        }
-                        elog_e("udp_task", "UDP sendto failed: %s, target=%s:%d, size=%d", error_desc,
-                               inet_ntoa(tx_msg.dest_addr.sin_addr), ntohs(tx_msg.dest_addr.sin_port), tx_msg.data_len);
-                    }
-                    else if (sent_bytes != tx_msg.data_len)
-                    {
-                        // 部分发送
-                        elog_w("udp_task", "UDP partial send: sent=%d, expected=%d", sent_bytes, tx_msg.data_len);
-                    }
-                    else
-                    {
-                        // 发送成功
-                        elog_v("udp_task", "UDP sent %d bytes to %s:%d", sent_bytes,
-                               inet_ntoa(tx_msg.dest_addr.sin_addr), ntohs(tx_msg.dest_addr.sin_port));
-                    }
-                }
-                break;
-
-            case MSG_TYPE_CLOSE_CONN:
-                break;
-
-            case MSG_TYPE_CONFIG:
-                break;
-
-            default:
-                break;
-            }
+            continue;
         }
 
-        // 非阻塞接收数据
-        recv_len =
-            recvfrom(sockfd, buffer, UDP_BUFFER_SIZE, MSG_DONTWAIT, (struct sockaddr *)&client_addr, &client_addr_len);
-        if (recv_len > 0)
+        uint32_t log_wait_ms = udp_rel_log_stats(now);
+        if (wait_ms == UDP_REL_NO_TIMER || log_wait_ms < wait_ms)
         {
-            // 构造接收消息 - 使用简单赋值避免memcpy
-            rx_msg.src_addr = client_addr;
-            rx_msg.data_len = recv_len;
-            for (int i = 0; i < recv_len && i < UDP_BUFFER_SIZE; i++)
-            {
-                rx_msg.data[i] = buffer[i];
-            }
-
-            // 将数据放入接收队列
-            if (osMessageQueuePut(rxQueue, &rx_msg, 0, 0) != osOK)
-            {
-                elog_w("udp_task", "UDP RX queue full, dropping packet from %s:%d (%d bytes)",
-                       inet_ntoa(client_addr.sin_addr), ntohs(client_addr.sin_port), recv_len);
-            }
-            else
-            {
-                elog_v("udp_task", "UDP received %d bytes from %s:%d", recv_len, inet_ntoa(client_addr.sin_addr),
-                       ntohs(client_addr.sin_port));
-            }
-
-            // 如果有回调函数，调用它
-            if (rx_callback != NULL)
-            {
-                rx_callback(&rx_msg);
-            }
+            wait_ms = log_wait_ms;
         }
-
-        osDelay(10); // 防止任务占满 CPU
+        osThreadFlagsWait(UDP_FLAG_RX | UDP_FLAG_TX, osFlagsWaitAny, wait_ms);
     }
 }
 
 // 初始化UDP通信任务
 void UDP_Task_Init(void)
 {
+    // 发送数据使用与UWB共享的帧缓冲池
+    FramePool_Init();
+
     // 创建消息队列
     txQueue = osMessageQueueNew(TX_QUEUE_SIZE, sizeof(tx_msg_t), NULL);
     if (txQueue == NULL)
@@ -189,6 +445,12 @@ void UDP_Task_Init(void)
         return;
     }
 
+    relQueue = osMessageQueueNew(UDP_REL_QUEUE_SIZE, sizeof(tx_msg_t), NULL);
+    if (relQueue == NULL)
+    {
+        return;
+    }
+
     rxQueue = osMessageQueueNew(RX_QUEUE_SIZE, sizeof(udp_rx_msg_t), NULL);
     if (rxQueue == NULL)
     {
@@ -204,6 +466,37 @@ void UDP_Task_Init(void)
     udpTaskHandle = osThreadNew(udp_comm_task, NULL, &udpTask_attributes);
 }
 
+// 把缓冲块投递给UDP任务，失败时释放缓冲块
+static int udp_enqueue(osMessageQueueId_t queue, frame_buf_t *buf, const char *ip_addr, uint16_t port,
+                       uint32_t timeout_ms)
+{
+    tx_msg_t msg;
+    msg.type = MSG_TYPE_SEND_DATA;
+    msg.dest_port = port;
+    msg.buf = buf;
+
+    // 设置目标地址
+    if (ipaddr_aton(ip_addr, &msg.dest_ip) == 0)
+    {
+        FramePool_Release(buf);
+        return -2; // 无效的IP地址
+    }
+
+    // 发送到队列
+    if (osMessageQueuePut(queue, &msg, 0, timeout_ms) != osOK)
+    {
+        FramePool_Release(buf);
+        return -3; // 队列满或超时
+    }
+
+    if (udpTaskHandle != NULL)
+    {
+        osThreadFlagsSet(udpTaskHandle, UDP_FLAG_TX);
+    }
+
+    return 0; // 成功
+}
+
 // API函数：发送UDP数据
 int UDP_SendData(const uint8_t *data, uint16_t len, const char *ip_addr, uint16_t port)
 {
@@ -212,31 +505,60 @@ int UDP_SendData(const uint8_t *data, uint16_t len, const char *ip_addr, uint16_
         return -1;
     }
 
-    tx_msg_t msg;
-    msg.type = MSG_TYPE_SEND_DATA;
-    msg.data_len = len;
+    frame_buf_t *buf = FramePool_Alloc(0);
+    if (buf == NULL)
+    {
+        return -4; // 缓冲池耗尽
+    }
 
-    // use memcpy to copy data
-    memcpy(msg.data, data, len);
+    // 唯一一次拷贝，之后缓冲块直接交给以太网DMA
+    memcpy(buf->data, data, len);
+    buf->len = len;
 
-    // 设置目标地址
-    msg.dest_addr.sin_family = AF_INET;
-    msg.dest_addr.sin_port = htons(port);
-    if (inet_aton(ip_addr, &msg.dest_addr.sin_addr) == 0)
+    return udp_enqueue(txQueue, buf, ip_addr, port, TX_ENQUEUE_TIMEOUT_MS);
+}
+
+// API函数：零拷贝发送UDP数据
+int UDP_SendFrame(frame_buf_t *buf, const char *ip_addr, uint16_t port)
+{
+    if (buf == NULL)
     {
-        return -2; // 无效的IP地址
+        return -1;
     }
 
-    // 发送到队列
-    if (osMessageQueuePut(txQueue, &msg, 0, 100) != osOK)
+    if (buf->len == 0 || buf->len > UDP_BUFFER_SIZE || ip_addr == NULL)
     {
-        return -3; // 队列满或超时
+        FramePool_Release(buf);
+        return -1;
     }
 
-    return 0; // 成功
+    return udp_enqueue(txQueue, buf, ip_addr, port, TX_ENQUEUE_TIMEOUT_MS);
+}
+
+// API函数：发送可靠上行数据
+int UDP_SendReliable(frame_buf_t *buf, const char *ip_addr, uint16_t port)
+{
+    if (buf == NULL)
+    {
+        return -1;
+    }
+
+    if (buf->len == 0 || buf->len > UDP_BUFFER_SIZE || ip_addr == NULL)
+    {
+        FramePool_Release(buf);
+        return -1;
+    }
+
+    // 窗口已满时不等待，避免阻塞采集数据的任务；丢弃数由统计日志定期输出，调用者照常收到-3
+    int ret = udp_enqueue(relQueue, buf, ip_addr, port, REL_ENQUEUE_TIMEOUT_MS);
+    if (ret == -3)
+    {
+        rel_queue_drops++;
+    }
+    return ret;
 }
 
-// API函数：接收UDP数据（非阻塞）
+// API函数：接收UDP数据
 int UDP_ReceiveData(udp_rx_msg_t *msg, uint32_t timeout_ms)
 {
     if (msg == NULL)
@@ -252,6 +574,19 @@ int UDP_ReceiveData(udp_rx_msg_t *msg, uint32_t timeout_ms)
     return -1; // 超时或错误
 }
 
+// API函数：归还接收消息持有的pbuf
+void UDP_ReleaseRxMsg(udp_rx_msg_t *msg)
+{
+    if (msg == NULL || msg->p == NULL)
+    {
+        return;
+    }
+
+    pbuf_free(msg->p);
+    msg->p = NULL;
+    msg->data_len = 0;
+}
+
 // API函数：设置接收回调函数
 void UDP_SetRxCallback(udp_rx_callback_t callback)
 {
@@ -264,6 +599,11 @@ int UDP_GetTxQueueCount(void)
     return (int)osMessageQueueGetCount(txQueue);
 }
 
+int UDP_GetTxQueueCapacity(void)
+{
+    return (int)osMessageQueueGetCapacity(txQueue);
+}
+
 int UDP_GetRxQueueCount(void)
 {
     return (int)osMessageQueueGetCount(rxQueue);
@@ -275,7 +615,8 @@ void UDP_ClearTxQueue(void)
     tx_msg_t msg;
     while (osMessageQueueGet(txQueue, &msg, NULL, 0) == osOK)
     {
-        // 清空队列
+        // 清空队列，归还缓冲块
+        FramePool_Release(msg.buf);
     }
 }
 
@@ -284,6 +625,7 @@ void UDP_ClearRxQueue(void)
     udp_rx_msg_t msg;
     while (osMessageQueueGet(rxQueue, &msg, NULL, 0) == osOK)
     {
-        // 清空队列
+        // 清空队列，归还pbuf
+        UDP_ReleaseRxMsg(&msg);
     }
 }
\ No newline at end of file
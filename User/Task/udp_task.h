@@ -1,6 +1,9 @@
 #ifndef UDP_TASK_H
 #define UDP_TASK_H
 
+#include "frame_pool.h"
+#include "lwip/pbuf.h"
+#include "udp_reliable.h"
 #include "lwip/sockets.h"
 #include <stdint.h>
 
@@ -10,16 +13,18 @@ extern "C"
 #endif
 
 #define UDP_BUFFER_SIZE 1016
+#define UDP_WAIT_FOREVER 0xFFFFFFFFU // UDP_ReceiveData一直等待直到收到数据
 
     // 接收消息结构体
+    // 数据通常不拷贝，直接引用以太网接收缓冲区中的pbuf链（接收积压时拷贝到PBUF_RAM），处理完后必须调用UDP_ReleaseRxMsg
     typedef struct
     {
         struct sockaddr_in src_addr; // 源地址
-        uint16_t data_len;
-        uint8_t data[UDP_BUFFER_SIZE];
+        uint16_t data_len;           // 数据总长度（p->tot_len）
+        struct pbuf *p;              // 接收数据，按 p->payload / p->len / p->next 逐段访问
     } udp_rx_msg_t;
 
-    // 接收数据回调函数指针
+    // 接收数据回调函数指针，msg只在回调期间有效
     typedef void (*udp_rx_callback_t)(const udp_rx_msg_t *msg);
 
     // 初始化UDP通信任务
@@ -27,21 +32,37 @@ extern "C"
 
     // API函数：发送UDP数据
     // 参数：data - 要发送的数据, len - 数据长度, ip_addr - 目标IP地址, port - 目标端口
-    // 返回：0 - 成功, -1 - 参数错误, -2 - 无效IP地址, -3 - 队列满或超时
+    // 数据拷贝一次到帧缓冲块，之后直接由以太网DMA发送
+    // 返回：0 - 成功, -1 - 参数错误, -2 - 无效IP地址, -3 - 队列满或超时, -4 - 缓冲池耗尽
     int UDP_SendData(const uint8_t *data, uint16_t len, const char *ip_addr, uint16_t port);
 
-    // API函数：接收UDP数据（非阻塞）
-    // 参数：msg - 接收消息缓冲区, timeout_ms - 超时时间（毫秒）
-    // 返回：0 - 成功, -1 - 超时或错误
+    // API函数：零拷贝发送UDP数据
+    // 参数：buf - 帧缓冲块（发送buf->len字节），调用者转交一个引用，无论成功与否都不能再使用该引用
+    //       缓冲块在以太网DMA发送完成后才归还缓冲池，期间内容不能被修改
+    // 返回：0 - 成功, -1 - 参数错误, -2 - 无效IP地址, -3 - 队列满或超时
+    int UDP_SendFrame(frame_buf_t *buf, const char *ip_addr, uint16_t port);
+
+    // API函数：零拷贝发送可靠上行数据（Slave2Backend批量数据）
+    // 后端开启可靠传输后按序号发送，丢失时从重传缓冲区补发，发送速率受拥塞窗口控制；未开启时等同于UDP_SendFrame
+    // 参数/返回：同UDP_SendFrame，但排队队列满时不等待，立即返回-3并计入丢弃数
+    int UDP_SendReliable(frame_buf_t *buf, const char *ip_addr, uint16_t port);
+
+    // API函数：接收UDP数据
+    // 参数：msg - 接收消息缓冲区, timeout_ms - 超时时间（毫秒），0为非阻塞，UDP_WAIT_FOREVER为一直等待
+    // 返回：0 - 成功（msg持有pbuf，需调用UDP_ReleaseRxMsg）, -1 - 超时或错误
     int UDP_ReceiveData(udp_rx_msg_t *msg, uint32_t timeout_ms);
 
+    // API函数：归还接收消息持有的pbuf
+    void UDP_ReleaseRxMsg(udp_rx_msg_t *msg);
+
     // API函数：设置接收回调函数
     // 参数：callback - 回调函数指针，当接收到数据时自动调用
     void UDP_SetRxCallback(udp_rx_callback_t callback);
 
     // API函数：获取队列状态
-    int UDP_GetTxQueueCount(void); // 获取发送队列中的消息数量
-    int UDP_GetRxQueueCount(void); // 获取接收队列中的消息数量
+    int UDP_GetTxQueueCount(void);    // 获取发送队列中的消息数量
+    int UDP_GetTxQueueCapacity(void); // 获取发送队列深度
+    int UDP_GetRxQueueCount(void);    // 获取接收队列中的消息数量
 
     // API函数：清空队列
     void UDP_ClearTxQueue(void); // 清空发送队列
@@ -1,6 +1,9 @@
 #include "uwb_task.h"
 
 #include "cmsis_os2.h"
+#include <atomic>
+#include <math.h>
+#include <string.h>
 #include <memory>
 
 #if UWB_CHIP_TYPE_DW1000
@@ -17,42 +20,340 @@ extern CX310_SlaveSpiAdapter *g_uwb_adapter;
 #endif
 
 #include "elog.h"
-
-#define TX_QUEUE_SIZE 10
+#include "frame_pool.h"
+#include "hptimer.hpp"
+#include "spi_speed.h"
+
+// 各发送类别的队列深度
+#define TX_SYNC_QUEUE_SIZE 2
+#define TX_CONTROL_QUEUE_SIZE 4
+#define TX_RETRY_QUEUE_SIZE 2
+#define TX_PING_QUEUE_SIZE 2
+#define TX_CONTROL_PUT_TIMEOUT_MS 100 // 控制类别队列满时的等待时间
 #define RX_QUEUE_SIZE 10
 
+// UWB任务事件标志（osThreadFlags）
+#define UWB_EVT_TX 0x01U // 发送队列有新数据
+#define UWB_EVT_RX 0x02U // 芯片INT引脚中断（CX310）
+#define UWB_EVT_ALL (UWB_EVT_TX | UWB_EVT_RX)
+#define UWB_IDLE_WAIT_MS 50 // 无事件时的兜底唤醒周期，防止漏掉中断边沿
+
+// 发送聚合：把排队的小帧拼接成一次空口发送（接收端按帧头逐帧拆分）
+#define UWB_TX_AGG_EN 1
+#define UWB_TX_AGG_HOLD_MS 1    // 聚合长度不足UWB_TX_AGG_SMALL_LEN时等待后续帧的最长时间
+#define UWB_TX_AGG_SMALL_LEN 64 // 聚合长度达到该值后不再等待，只拼接已排队的帧
+
 // UWB消息类型定义
 typedef enum
 {
     UWB_MSG_TYPE_SEND_DATA = 1, // 应用任务发送数据
     UWB_MSG_TYPE_CONFIG,        // 配置信息
     UWB_MSG_TYPE_SET_MODE,      // 设置工作模式
-    UWB_MSG_TYPE_SET_CHANNEL    // 设置信道
+    UWB_MSG_TYPE_SET_CHANNEL,   // 设置信道
+    UWB_MSG_TYPE_SET_PROFILE    // 切换PHY档位
 } uwb_msg_type_t;
 
-// UWB发送消息结构体
+// UWB发送消息结构体，数据放在缓冲池中，队列只传递句柄
 typedef struct
 {
     uwb_msg_type_t type;
-    uint16_t data_len;
-    uint8_t data[FRAME_LEN_MAX];
+    frame_buf_t *buf;  // 待发送数据（SEND_DATA），由通信任务发送后释放
+    uint8_t param;     // 配置参数（SET_CHANNEL时为信道号，SET_PROFILE时为档位）
     uint32_t delay_ms; // 发送延迟时间
 } uwb_tx_msg_t;
 
+// 队列满时的处理策略
+typedef enum
+{
+    UWB_TX_DROP_OLDEST, // 丢弃队列中最旧的帧，新帧入队
+    UWB_TX_WAIT,        // 等待超时，仍满则拒绝新帧
+    UWB_TX_DROP_NEWEST  // 直接拒绝新帧
+} uwb_tx_drop_policy_t;
+
+// 发送类别上下文
+typedef struct
+{
+    osMessageQueueId_t queue;
+    uint16_t depth;
+    uwb_tx_drop_policy_t policy;
+    std::atomic<uint32_t> enqueued;
+    std::atomic<uint32_t> sent;
+    std::atomic<uint32_t> dropped;
+    std::atomic<uint16_t> highWater;
+} uwb_tx_class_ctx_t;
+
+static uwb_tx_class_ctx_t uwb_txClasses[UWB_TX_CLASS_NUM];
+
+// 聚合时取出但放不下的消息，下次优先于非同步类别发送，只由UWB任务访问
+static uwb_tx_msg_t uwb_txCarry;
+static volatile bool uwb_txCarryValid = false;
+// UWB_ClearTxQueue()请求丢弃遗留消息，由UWB任务在下次取消息时处理
+static volatile bool uwb_txCarryDrop = false;
+static uwb_tx_agg_stats_t uwb_txAggStats;
+
+// 最近一次同步帧的实际发送时刻，只由UWB任务写入
+static uwb_tx_time_t uwb_syncTxTime;
+
 // 全局变量
-static osMessageQueueId_t uwb_txQueue; // UWB发送队列
 static osMessageQueueId_t uwb_rxQueue; // UWB接收队列
 static osThreadId_t uwbCommTaskHandle;
-static osSemaphoreId_t uwb_txSemaphore; // UWB发送信号量
 
 // 接收数据回调函数指针
 typedef void (*uwb_rx_callback_t)(const uwb_rx_msg_t *msg);
 static uwb_rx_callback_t uwb_rx_callback = NULL;
 
+// 射频配置快照，只由UWB任务写入
+static uwb_radio_state_t uwb_radio_state;
+// 当前PHY档位，只由UWB任务写入
+static uint8_t uwb_phy_profile = UWB_PHY_PROFILE_DEFAULT;
+
+// 发布射频配置快照（UWB任务上下文）
+static void uwb_publish_radio_state(const uwb_radio_state_t *state)
+{
+    osKernelLock();
+    uwb_radio_state = *state;
+    uwb_radio_state.profile = uwb_phy_profile;
+    uwb_radio_state.valid = 1;
+    uwb_radio_state.updated_tick = osKernelGetTickCount();
+    osKernelUnlock();
+}
+
+// 记录同步帧的实际发送时刻（UWB任务上下文）
+static void uwb_publish_sync_tx_time(uint64_t tx_time_us)
+{
+    osKernelLock();
+    uwb_syncTxTime.tx_time_us = tx_time_us;
+    uwb_syncTxTime.seq++;
+    osKernelUnlock();
+}
+
+// 按类别入队，队列满时根据类别策略处理；无论成功与否msg->buf的所有权都转移给本函数
+static int uwb_tx_enqueue(uwb_tx_class_t tx_class, const uwb_tx_msg_t *msg)
+{
+    uwb_tx_class_ctx_t *ctx = &uwb_txClasses[tx_class];
+
+    osStatus_t status = osMessageQueuePut(ctx->queue, msg, 0, 0);
+    if (status != osOK)
+    {
+        switch (ctx->policy)
+        {
+        case UWB_TX_DROP_OLDEST: {
+            // 挤出最旧的帧并归还其缓冲块
+            uwb_tx_msg_t stale;
+            if (osMessageQueueGet(ctx->queue, &stale, NULL, 0) == osOK)
+            {
+                FramePool_Release(stale.buf);
+                ctx->dropped++;
+            }
+            status = osMessageQueuePut(ctx->queue, msg, 0, 0);
+            break;
+        }
+        case UWB_TX_WAIT:
+            status = osMessageQueuePut(ctx->queue, msg, 0, TX_CONTROL_PUT_TIMEOUT_MS);
+            break;
+        case UWB_TX_DROP_NEWEST:
+        default:
+            break;
+        }
+    }
+
+    if (status != osOK)
+    {
+        // 入队失败，缓冲块由本函数负责释放
+        FramePool_Release(msg->buf);
+        ctx->dropped++;
+        return -3; // 队列满或超时
+    }
+
+    ctx->enqueued++;
+    uint16_t count = (uint16_t)osMessageQueueGetCount(ctx->queue);
+    uint16_t high = ctx->highWater.load(std::memory_order_relaxed);
+    while (count > high && !ctx->highWater.compare_exchange_weak(high, count, std::memory_order_relaxed))
+    {
+    }
+
+    // 队列数据放入成功后，通知通信任务（任务尚未创建完成时由兜底唤醒处理）
+    if (uwbCommTaskHandle != NULL)
+    {
+        osThreadFlagsSet(uwbCommTaskHandle, UWB_EVT_TX);
+    }
+    return 0;
+}
+
+// 从指定类别队列取出一条消息并计入该类别的发送统计
+static bool uwb_tx_get(int tx_class, uwb_tx_msg_t *msg)
+{
+    if (osMessageQueueGet(uwb_txClasses[tx_class].queue, msg, NULL, 0) != osOK)
+    {
+        return false;
+    }
+    uwb_txClasses[tx_class].sent++;
+    return true;
+}
+
+// 按优先级从高到低取出一帧待发送数据；聚合遗留的消息排在同步帧之后、其余类别之前
+static bool uwb_tx_dequeue(uwb_tx_msg_t *msg, bool *is_sync)
+{
+    if (uwb_txCarryDrop)
+    {
+        uwb_txCarryDrop = false;
+        if (uwb_txCarryValid)
+        {
+            uwb_txCarryValid = false;
+            FramePool_Release(uwb_txCarry.buf);
+        }
+    }
+    *is_sync = uwb_tx_get(UWB_TX_CLASS_SYNC, msg);
+    if (*is_sync)
+    {
+        return true;
+    }
+    if (uwb_txCarryValid)
+    {
+        *msg = uwb_txCarry;
+        uwb_txCarryValid = false;
+        return true;
+    }
+    for (int i = UWB_TX_CLASS_SYNC + 1; i < UWB_TX_CLASS_NUM; i++)
+    {
+        if (uwb_tx_get(i, msg))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if UWB_TX_AGG_EN
+// 把后续排队的数据帧追加到msg->buf，直到放不下、遇到非数据消息或有同步帧到达
+// 聚合长度较小时最多等待UWB_TX_AGG_HOLD_MS，等待期间只消耗TX事件，RX事件留给主循环
+static uint16_t uwb_tx_aggregate(uwb_tx_msg_t *msg)
+{
+    uint16_t frames = 1;
+    uint32_t start = osKernelGetTickCount();
+
+    // 缓冲块被其他使用者持有时不能原地追加
+    if (msg->buf->refcnt != 1)
+    {
+        return frames;
+    }
+
+    for (;;)
+    {
+        // 同步帧到达时立即结束聚合
+        if (osMessageQueueGetCount(uwb_txClasses[UWB_TX_CLASS_SYNC].queue) > 0)
+        {
+            break;
+        }
+
+        uwb_tx_msg_t next;
+        bool is_sync;
+        if (!uwb_tx_dequeue(&next, &is_sync))
+        {
+            uint32_t elapsed = osKernelGetTickCount() - start;
+            if (msg->buf->len >= UWB_TX_AGG_SMALL_LEN || elapsed >= UWB_TX_AGG_HOLD_MS)
+            {
+                break;
+            }
+            osThreadFlagsWait(UWB_EVT_TX, osFlagsWaitAny, UWB_TX_AGG_HOLD_MS - elapsed);
+            continue;
+        }
+
+        if (is_sync || next.type != UWB_MSG_TYPE_SEND_DATA || msg->buf->len + next.buf->len > FRAME_LEN_MAX)
+        {
+            // 放不下的消息留到下一次发送，保持原有顺序
+            uwb_txCarry = next;
+            uwb_txCarryValid = true;
+            break;
+        }
+
+        memcpy(msg->buf->data + msg->buf->len, next.buf->data, next.buf->len);
+        msg->buf->len += next.buf->len;
+        FramePool_Release(next.buf);
+        frames++;
+    }
+    return frames;
+}
+#endif
+
+// 取出下一条待处理消息，数据帧（同步帧除外）在此完成聚合
+// is_sync返回该消息是否为同步帧，用于记录其实际发送时刻
+static bool uwb_tx_next(uwb_tx_msg_t *msg, bool *is_sync)
+{
+    if (!uwb_tx_dequeue(msg, is_sync))
+    {
+        return false;
+    }
+    if (msg->type != UWB_MSG_TYPE_SEND_DATA)
+    {
+        return true;
+    }
+
+    uint16_t frames = 1;
+#if UWB_TX_AGG_EN
+    if (!*is_sync)
+    {
+        frames = uwb_tx_aggregate(msg);
+    }
+#endif
+    uwb_txAggStats.transmissions++;
+    uwb_txAggStats.frames += frames;
+    if (frames > 1)
+    {
+        uwb_txAggStats.aggregated++;
+    }
+    if (frames > uwb_txAggStats.maxFrames)
+    {
+        uwb_txAggStats.maxFrames = frames;
+    }
+    return true;
+}
+
+// 将接收到的帧投递给应用，rx_msg->buf的所有权转移给接收队列
+static void uwb_rx_deliver(uwb_rx_msg_t *rx_msg)
+{
+    // 回调在入队前执行，此时缓冲块仍由通信任务持有
+    if (uwb_rx_callback != NULL)
+    {
+        uwb_rx_callback(rx_msg);
+    }
+
+    if (osMessageQueuePut(uwb_rxQueue, rx_msg, 0, 0) != osOK)
+    {
+        FramePool_Release(rx_msg->buf);
+    }
+    rx_msg->buf = NULL;
+    rx_msg->data = NULL;
+}
+
 #if UWB_CHIP_TYPE_DW1000
-static uint8_t rx_buffer[FRAME_LEN_MAX];
-static uint32_t status_reg = 0;
-static uint16_t frame_len = 0;
+#define UWB_EVT_TX_DONE 0x04U           // 发送完成（dwt_isr回调）
+#define UWB_DW_TX_DONE_TIMEOUT_MS 100   // 最长帧在110kbps下约80ms
+#define UWB_DW_INT_MASK                                                                                                \
+    (DWT_INT_TFRS | DWT_INT_RFCG | DWT_INT_RPHE | DWT_INT_RFCE | DWT_INT_RFSL | DWT_INT_RFTO | DWT_INT_RXPTO |         \
+     DWT_INT_SFDT | DWT_INT_ARFE)
+
+// DW1000系统时钟：40位计数，1单位 = 1/(128*499.2MHz)，即 1us = 63897.6单位
+#define UWB_DW_TIME_MASK 0xFFFFFFFFFFULL
+#define UWB_DW_TIME_UNITS_PER_10US 638976ULL
+
+// 接收成功中断只锁存帧长度和状态，帧留在主机侧接收缓冲区，由UWB任务读出后释放
+// 释放前芯片不会上报另一块缓冲区中的帧，所以同一时刻最多只有一帧待读
+static volatile bool uwb_dwRxPending;
+static volatile uint16_t uwb_dwRxLen;
+static volatile uint32_t uwb_dwRxStatus;
+static volatile uint32_t uwb_dwRxTick;
+
+// PHY档位参数表，下标为uwb_phy_profile_t
+static const dwt_config_t uwb_phy_profiles[UWB_PHY_PROFILE_NUM] = {
+    // 高吞吐：6.8Mbps + 128符号前导码
+    {5, DWT_PRF_64M, DWT_PLEN_128, DWT_PAC8, 9, 9, 0, DWT_BR_6M8, DWT_PHRMODE_EXT, (129 + 8 - 8)},
+    // 均衡：与上电默认配置一致
+    {5, DWT_PRF_64M, DWT_PLEN_1024, DWT_PAC32, 9, 9, 0, DWT_BR_850K, DWT_PHRMODE_EXT, (1025 + 64 - 32)},
+    // 远距离：110kbps需要非标准SFD和更长的前导码
+    {5, DWT_PRF_64M, DWT_PLEN_2048, DWT_PAC64, 9, 9, 1, DWT_BR_110K, DWT_PHRMODE_EXT, (2049 + 64 - 64)},
+};
+
 /* Default communication configuration. */
 static dwt_config_t config = {
     5,               // 通道号，推荐5或2，5抗干扰稍强
@@ -67,12 +368,166 @@ static dwt_config_t config = {
     (1025 + 64 - 32) // SFD超时时间：可按 PLEN + margin 设置
 };
 
+// 根据DW1000诊断寄存器估算接收信号强度和首径信噪比 (User Manual 4.7)
+static void uwb_read_link_quality(int8_t *rssi, uint8_t *quality)
+{
+    dwt_rxdiag_t diag;
+    dwt_readdiagnostics(&diag);
+
+    *rssi = UWB_RSSI_UNKNOWN;
+    *quality = UWB_QUALITY_UNKNOWN;
+    if (diag.rxPreamCount == 0)
+    {
+        return;
+    }
+
+    const float a = (config.prf == DWT_PRF_64M) ? 121.74f : 113.77f;
+    const float n = (float)diag.rxPreamCount;
+    float level = 10.0f * log10f(((float)diag.maxGrowthCIR * 131072.0f) / (n * n)) - a;
+    if (level < -127.0f)
+        level = -127.0f;
+    if (level > 0.0f)
+        level = 0.0f;
+    *rssi = (int8_t)level;
+
+    if (diag.stdNoise > 0 && diag.firstPathAmp2 > 0)
+    {
+        float snr = 20.0f * log10f((float)diag.firstPathAmp2 / (float)diag.stdNoise);
+        if (snr < 0.0f)
+            snr = 0.0f;
+        if (snr > 254.0f)
+            snr = 254.0f;
+        *quality = (uint8_t)snr;
+    }
+}
+
+// 按当前dwt_config_t发布射频配置快照
+static void uwb_publish_dw1000_state(void)
+{
+    uwb_radio_state_t state = {};
+    state.channel = config.chan;
+    state.prf_mode = config.prf;
+    state.preamble_length = config.txPreambLength;
+    state.preamble_index = config.txCode;
+    state.data_rate = config.dataRate;
+    uwb_publish_radio_state(&state);
+}
+
+// SPI速率校验：设备ID读回 + TX缓冲区写入/读回
+static int uwb_spi_verify(void *ctx)
+{
+    static const uint8_t pattern[8] = {0x55, 0xAA, 0x00, 0xFF, 0x0F, 0xF0, 0x5A, 0xA5};
+    uint8_t readback[sizeof(pattern)];
+
+    if (dwt_readdevid() != DWT_DEVICE_ID)
+    {
+        return 0;
+    }
+
+    dwt_writetodevice(TX_BUFFER_ID, 0, sizeof(pattern), pattern);
+    dwt_readfromdevice(TX_BUFFER_ID, 0, sizeof(readback), readback);
+    return memcmp(pattern, readback, sizeof(pattern)) == 0;
+}
+
+// 读取5字节DW1000时间戳
+static uint64_t uwb_dw_get_time(void (*read_fn)(uint8 *))
+{
+    uint8 ts[5];
+    read_fn(ts);
+    uint64_t value = 0;
+    for (int i = 4; i >= 0; i--)
+    {
+        value = (value << 8) | ts[i];
+    }
+    return value;
+}
+
+// 把芯片时间戳换算到hptimer微秒时基：以当前芯片时间和主机时间为参照回推
+// 时间戳须在芯片时钟回绕周期（约17.2s）内换算
+static uint64_t uwb_dw_to_host_us(uint64_t dw_time)
+{
+    uint64_t dw_now = uwb_dw_get_time(dwt_readsystime);
+    uint64_t host_now = hal_hptimer_get_us64();
+    uint64_t elapsed_us = ((dw_now - dw_time) & UWB_DW_TIME_MASK) * 10 / UWB_DW_TIME_UNITS_PER_10US;
+    return (elapsed_us < host_now) ? host_now - elapsed_us : 0;
+}
+
+// 接收成功回调（dwt_isr，中断上下文）
+// 只让接收机在另一块缓冲区继续接收并锁存帧信息，SPI读帧、诊断和RSSI计算都在任务中完成
+static void uwb_dw_rx_ok_cb(const dwt_cb_data_t *cb_data)
+{
+    dwt_rxenable(DWT_START_RX_IMMEDIATE | DWT_NO_SYNC_PTRS);
+
+    uwb_dwRxLen = cb_data->datalength;
+    uwb_dwRxStatus = cb_data->status;
+    uwb_dwRxTick = osKernelGetTickCount();
+    uwb_dwRxPending = true;
+    osThreadFlagsSet(uwbCommTaskHandle, UWB_EVT_RX);
+}
+
+// 读出主机侧缓冲区中的帧并投递给应用，随后释放缓冲区
+static void uwb_dw_rx_service(void)
+{
+    uwb_rx_msg_t rx_msg;
+    rx_msg.buf = NULL;
+
+    // 读帧期间屏蔽DW1000中断，避免dwt_isr与任务同时访问SPI
+    decaIrqStatus_t stat = decamutexon();
+    if (!uwb_dwRxPending)
+    {
+        decamutexoff(stat);
+        return;
+    }
+
+    // datalength包含2字节CRC；缓冲池耗尽时丢弃该帧
+    uint16_t frame_len = uwb_dwRxLen;
+    if (frame_len >= 2 && frame_len <= FRAME_LEN_MAX)
+    {
+        rx_msg.buf = FramePool_Alloc(0);
+    }
+    if (rx_msg.buf != NULL)
+    {
+        // 直接读入缓冲块，CRC一并读出但不计入长度；时间戳和诊断寄存器同样属于主机侧缓冲区
+        dwt_readrxdata(rx_msg.buf->data, frame_len, 0);
+        rx_msg.buf->len = frame_len - 2;
+        rx_msg.data = rx_msg.buf->data;
+        rx_msg.data_len = rx_msg.buf->len;
+        rx_msg.timestamp = uwb_dwRxTick;
+        rx_msg.rx_time_us = uwb_dw_to_host_us(uwb_dw_get_time(dwt_readrxtimestamp));
+        rx_msg.status_reg = uwb_dwRxStatus;
+        uwb_read_link_quality(&rx_msg.rssi, &rx_msg.quality);
+    }
+
+    // 释放后另一块缓冲区中已收到的帧会立即再次触发中断
+    uwb_dwRxPending = false;
+    dwt_releaserxbuff();
+    decamutexoff(stat);
+
+    if (rx_msg.buf != NULL)
+    {
+        uwb_rx_deliver(&rx_msg);
+    }
+}
+
+// 发送完成回调：芯片已按DWT_RESPONSE_EXPECTED自动打开接收，只需唤醒任务
+static void uwb_dw_tx_done_cb(const dwt_cb_data_t *cb_data)
+{
+    (void)cb_data;
+    osThreadFlagsSet(uwbCommTaskHandle, UWB_EVT_TX_DONE);
+}
+
+// 接收超时/错误回调：dwt_isr已关闭并复位接收机，重新启动接收
+static void uwb_dw_rx_err_cb(const dwt_cb_data_t *cb_data)
+{
+    (void)cb_data;
+    dwt_rxenable(DWT_START_RX_IMMEDIATE);
+}
+
 // UWB通信任务
 static void uwb_comm_task(void *argument)
 {
     static const char *TAG = "uwb_comm";
     uwb_tx_msg_t tx_msg;
-    uwb_rx_msg_t rx_msg;
 
     // 初始化DW1000
     reset_DW1000();
@@ -82,210 +537,346 @@ static void uwb_comm_task(void *argument)
         elog_e(TAG, "dwt_initialise failed");
         osThreadExit();
     }
-    port_set_dw1000_fastrate();
+    // PLL锁定后从低速逐档提速，停在读回校验通过的最快档位
+    SpiSpeed_Negotiate(uwb_spi_verify, NULL, SPI_SPEED_MAX_HZ_DW1000);
 
     // 配置DW1000
     dwt_configure(&config);
+    uwb_publish_dw1000_state();
     elog_i(TAG, "dwt_configure success");
 
-    // uint32_t device_id = dwt_readdevid();
-    // elog_i(TAG, "device_id: %08X", device_id);
+    // 中断驱动：发送完成、接收成功、接收超时/错误都由dwt_isr回调处理
+    dwt_setcallbacks(uwb_dw_tx_done_cb, uwb_dw_rx_ok_cb, uwb_dw_rx_err_cb, uwb_dw_rx_err_cb);
+    dwt_setinterrupt(UWB_DW_INT_MASK, 1);
+    // 接收双缓冲：任务读出上一帧的同时接收机已在接收下一帧，主机侧缓冲区由任务读完后释放
+    dwt_setdblrxbuffmode(1);
+    dwt_setdblrxbuffdefer(1);
+    // 发送结束后立即打开接收，不经过任务
+    dwt_setrxaftertxdelay(0);
+    setup_DW1000IRQ();
+    port_set_deca_isr(dwt_isr);
 
     // 启动接收模式
     dwt_rxenable(DWT_START_RX_IMMEDIATE);
 
-    while (1)
+    uint32_t wait_ms = 0;
+    bool is_sync;
+    for (;;)
     {
-        // 等待发送信号量，确保队列中有完整的数据
-        if (osSemaphoreAcquire(uwb_txSemaphore, 0) == osOK)
+        // 阻塞等待发送队列事件或接收中断；仍有积压时不阻塞
+        osThreadFlagsWait(UWB_EVT_ALL, osFlagsWaitAny, wait_ms);
+
+        // 兜底：IRQ线保持高电平时不会再产生新的边沿，在任务中处理一次
+        if (port_CheckEXT_IRQ() != 0)
+        {
+            decaIrqStatus_t stat = decamutexon();
+            process_deca_irq();
+            decamutexoff(stat);
+        }
+
+        // 先读出已收到的帧，发送期间接收机在另一块缓冲区继续接收
+        uwb_dw_rx_service();
+
+        // 按优先级获取发送消息
+        if (uwb_tx_next(&tx_msg, &is_sync))
         {
-            // 从队列获取发送消息
-            if (osMessageQueueGet(uwb_txQueue, &tx_msg, NULL, 0) == osOK)
+            switch (tx_msg.type)
             {
-                switch (tx_msg.type)
+            case UWB_MSG_TYPE_SEND_DATA: {
+                dwt_forcetrxoff(); // 保证发送前DW1000已空闲
+
+                // 发送UWB数据
+                // DW1000会自动添加2字节CRC，所以实际写入的数据长度是用户数据长度
+                // 但是dwt_writetxfctrl需要包含CRC的总长度
+                dwt_writetxdata(tx_msg.buf->len + 2, tx_msg.buf->data, 0);
+                dwt_writetxfctrl(tx_msg.buf->len + 2, 0, 1);
+
+                // 等待发送完成中断；发送结束后芯片自动回到接收
+                osThreadFlagsClear(UWB_EVT_TX_DONE);
+                uint32_t flags = osFlagsErrorTimeout;
+                if (dwt_starttx(DWT_START_TX_IMMEDIATE | DWT_RESPONSE_EXPECTED) == DWT_SUCCESS)
                 {
-                case UWB_MSG_TYPE_SEND_DATA:
-                    dwt_forcetrxoff(); // 保证发送前DW1000已空闲
-
-                    // 发送UWB数据
-                    // DW1000会自动添加2字节CRC，所以实际写入的数据长度是用户数据长度
-                    // 但是dwt_writetxfctrl需要包含CRC的总长度
-                    dwt_writetxdata(tx_msg.data_len + 2, tx_msg.data, 0);
-                    dwt_writetxfctrl(tx_msg.data_len + 2, 0, 1);
-                    dwt_starttx(DWT_START_TX_IMMEDIATE);
-
-                    // 等待发送完成
-                    while (!(dwt_read32bitreg(SYS_STATUS_ID) & SYS_STATUS_TXFRS))
-                    {
-                        osDelay(1);
-                    }
-                    dwt_write32bitreg(SYS_STATUS_ID, SYS_STATUS_TXFRS);
-
-                    // 发送完成后重新启动接收
+                    flags = osThreadFlagsWait(UWB_EVT_TX_DONE, osFlagsWaitAny, UWB_DW_TX_DONE_TIMEOUT_MS);
+                }
+                if (flags & osFlagsError)
+                {
+                    elog_e(TAG, "TX done timeout, len %d", tx_msg.buf->len);
+                    dwt_forcetrxoff();
                     dwt_rxenable(DWT_START_RX_IMMEDIATE);
+                }
+                else if (is_sync)
+                {
+                    // TX时间戳对应帧的RMARKER，即同步帧实际离开天线的时刻
+                    uwb_publish_sync_tx_time(uwb_dw_to_host_us(uwb_dw_get_time(dwt_readtxtimestamp)));
+                }
 
-                    // elog_i(TAG, "Sent %d bytes done", tx_msg.data_len);
-                    break;
-
-                case UWB_MSG_TYPE_CONFIG:
-                    // 重新配置DW1000
+                // elog_i(TAG, "Sent %d bytes done", tx_msg.buf->len);
+                FramePool_Release(tx_msg.buf);
+            }
+            break;
+
+            case UWB_MSG_TYPE_CONFIG:
+                // 重新配置DW1000
+                dwt_forcetrxoff();
+                dwt_configure(&config);
+                uwb_publish_dw1000_state();
+                dwt_rxenable(DWT_START_RX_IMMEDIATE);
+                elog_i(TAG, "Config updated");
+                break;
+
+            case UWB_MSG_TYPE_SET_PROFILE:
+                // 切换PHY档位，保持当前信道
+                {
+                    uint8_t chan = config.chan;
+                    config = uwb_phy_profiles[tx_msg.param];
+                    config.chan = chan;
+                    uwb_phy_profile = tx_msg.param;
+                    dwt_forcetrxoff();
                     dwt_configure(&config);
+                    uwb_publish_dw1000_state();
                     dwt_rxenable(DWT_START_RX_IMMEDIATE);
-                    elog_i(TAG, "Config updated");
-                    break;
+                    elog_i(TAG, "PHY profile %d applied", tx_msg.param);
+                }
+                break;
 
-                case UWB_MSG_TYPE_SET_MODE:
-                    // 设置工作模式（预留接口）
-                    elog_i(TAG, "Mode set");
-                    break;
+            case UWB_MSG_TYPE_SET_MODE:
+                // 设置工作模式（预留接口）
+                elog_i(TAG, "Mode set");
+                break;
 
-                default:
-                    break;
-                }
+            default:
+                break;
             }
         }
 
-        // 检查是否有接收数据
-        status_reg = dwt_read32bitreg(SYS_STATUS_ID);
-        if (status_reg & (SYS_STATUS_RXFCG | SYS_STATUS_ALL_RX_ERR))
-        {
-            // elog_i(TAG, "status_reg: %08X", status_reg);
-            if (status_reg & SYS_STATUS_RXFCG)
-            {
-                // 成功接收到数据
-                frame_len = dwt_read32bitreg(RX_FINFO_ID) & RX_FINFO_RXFL_MASK_1023;
-                // elog_i(TAG, "frame_len: %d", frame_len);
+        // 发送期间收到的帧
+        uwb_dw_rx_service();
 
-                // frame_len包含2字节CRC，需要减去CRC长度得到实际数据长度
-                if (frame_len >= 2 && frame_len <= FRAME_LEN_MAX)
-                {
-                    dwt_readrxdata(rx_buffer, frame_len, 0);
+        // 发送队列未清空时立即继续，否则等待事件
+        wait_ms = (UWB_GetTxQueueCount() > 0) ? 0 : UWB_IDLE_WAIT_MS;
+    }
+}
+#elif UWB_CHIP_TYPE_CX310
 
-                    // 构造接收消息，只包含用户数据，不包含CRC
-                    rx_msg.data_len = frame_len - 2; // 减去2字节CRC
-                    for (int i = 0; i < rx_msg.data_len; i++)
-                    {
-                        rx_msg.data[i] = rx_buffer[i];
-                    }
-                    rx_msg.timestamp = osKernelGetTickCount();
-                    rx_msg.status_reg = status_reg;
+#define UWB_TX_DELAY_MS 0
 
-                    // 将数据放入接收队列
-                    osMessageQueuePut(uwb_rxQueue, &rx_msg, 0, 0);
+// 自动接收：芯片在每次发送完成后自行回到接收，省去一次UCI命令往返
+// 从机最早在下一个1ms TDMA时隙应答，接收使能延时需明显小于1ms
+#define UWB_AUTO_RX_EN 1
+#define UWB_AUTO_RX_DELAY_US 100
+// 接收超时有意设为0（一直接收）而不按TDMA时隙调整：主机需要在整个周期内接收所有从机的应答，
+// 超时关闭接收机后只能由主机补发接收命令，反而重新引入了补发延时
+#define UWB_AUTO_RX_TIMEOUT_US 0 // 0表示一直接收，直到下一次发送
+
+// PHY档位参数表，下标为uwb_phy_profile_t；切换时保留当前信道
+static const CX310PhyConfig uwb_phy_profiles[UWB_PHY_PROFILE_NUM] = {
+    // 高吞吐：HPRF 32符号前导码 + 31.2Mbps
+    {PARAM_CHANNEL_NUMBER_5, PARAM_PHYDATARATE_DRHM_HR, 2, PARAM_PRF_NOMINAL_64_M, PARAM_PREAMBLE_LEN_HPRF_32, 9,
+     PARAM_PSDU_DATA_RATE_31_2, UWB_AUTO_RX_DELAY_US, 3},
+    // 均衡：除接收使能延时外与CX310::init()默认配置一致
+    {PARAM_CHANNEL_NUMBER_5, PARAM_PHYDATARATE_DRHM_HR, 2, PARAM_PRF_NOMINAL_64_M, PARAM_PREAMBLE_LEN_BPRF_64, 9,
+     PARAM_PSDU_DATA_RATE_7_8, UWB_AUTO_RX_DELAY_US, 3},
+    // 远距离：BPRF 1024符号前导码 + 850kbps
+    {PARAM_CHANNEL_NUMBER_5, PARAM_PHYDATARATE_DRBM_LP, 0, PARAM_PRF_NOMINAL_64_M, PARAM_PREAMBLE_LEN_BPRF_1024, 9,
+     PARAM_PSDU_DATA_RATE_0_85, UWB_AUTO_RX_DELAY_US, 3},
+};
 
-                    // 如果有回调函数，调用它
-                    if (uwb_rx_callback != NULL)
-                    {
-                        uwb_rx_callback(&rx_msg);
-                    }
-                }
+// SPI速率校验上下文：以低速下读到的信道号作为参考值
+typedef struct
+{
+    CX310<CX310_SlaveSpiAdapter> *uwb;
+    uint8_t channel;
+} uwb_spi_verify_ctx_t;
 
-                // 清除接收完成标志
-                dwt_write32bitreg(SYS_STATUS_ID, SYS_STATUS_RXFCG);
-            }
-            else
-            {
-                // 接收错误
-                dwt_write32bitreg(SYS_STATUS_ID, SYS_STATUS_ALL_RX_ERR);
-                elog_e(TAG, "RX error: %08X", status_reg);
-            }
+// SPI速率校验：一次完整的UCI命令/响应往返，并比对读回的信道号（绕过影子表）
+static int uwb_spi_verify(void *ctx)
+{
+    uwb_spi_verify_ctx_t *verify = (uwb_spi_verify_ctx_t *)ctx;
+    uint8_t channel = 0;
+    return verify->uwb->query_config(PARAM_CHANNEL_NUMBER_ID, 1, &channel) && channel == verify->channel;
+}
 
-            // 重新启动接收
-            dwt_rxenable(DWT_START_RX_IMMEDIATE);
-        }
+// 从驱动影子表发布射频配置快照，影子值有效时不产生SPI访问
+static void uwb_publish_cx310_state(CX310<CX310_SlaveSpiAdapter> *uwb)
+{
+    uwb_radio_state_t state = {};
+    if (!uwb->get_channel(state.channel))
+    {
+        return;
     }
+    uwb->get_prf_mode(state.prf_mode);
+    uwb->get_preamble_length(state.preamble_length);
+    uwb->get_preamble_index(state.preamble_index);
+    uwb->get_psdu_data_rate(state.data_rate);
+    uwb_publish_radio_state(&state);
 }
-#elif UWB_CHIP_TYPE_CX310
-
-#define UWB_TX_DELAY_MS 0
 
 static void uwb_comm_task(void *argument)
 {
     static const char *TAG = "uwb_comm";
 
-    auto tx_msg = std::make_unique<uwb_tx_msg_t>();
-    auto rx_msg = std::make_unique<uwb_rx_msg_t>();
+    uwb_tx_msg_t tx_msg;
+    uwb_rx_msg_t rx_msg;
 
     // 在堆上创建CX310对象，避免栈溢出
     auto uwb = std::make_unique<CX310<CX310_SlaveSpiAdapter>>();
     // 设置全局指针，用于中断处理
     g_uwb_adapter = &uwb->get_interface();
+    // INT引脚中断直接唤醒本任务
+    g_uwb_adapter->set_irq_notify(osThreadGetId(), UWB_EVT_RX);
 
-    std::vector<uint8_t> buffer = {0};
-
+    // 复位和启动阶段使用低速率
+    SpiSpeed_SetSlow();
     if (uwb->init())
     {
         elog_i(TAG, "uwb.init success");
     }
+
+    // 启动完成后协商SPI速率
+    uwb_spi_verify_ctx_t verify_ctx = {uwb.get(), 0};
+    if (uwb->query_config(PARAM_CHANNEL_NUMBER_ID, 1, &verify_ctx.channel))
+    {
+        SpiSpeed_Negotiate(uwb_spi_verify, &verify_ctx, SPI_SPEED_MAX_HZ_CX310);
+    }
+    else
+    {
+        elog_w(TAG, "SPI readback unavailable, keeping %lu Hz", (unsigned long)SpiSpeed_GetClockHz());
+    }
+    uwb_publish_cx310_state(uwb.get());
+#if UWB_AUTO_RX_EN
+    // 开启失败时由驱动在每次发送完成后补发接收命令
+    if (!uwb->set_auto_recv(UWB_AUTO_RX_DELAY_US, UWB_AUTO_RX_TIMEOUT_US))
+    {
+        elog_w(TAG, "auto recv unavailable, re-arming RX after each TX");
+    }
+#endif
     osDelay(3);
     uwb->set_recv_mode();
 
+    uint32_t wait_ms = 0;
+    bool is_sync;
+    // 同步帧发送前的发送完成计数；计数变化时对应的INT中断时刻即为发送时刻
+    bool sync_tx_pending = false;
+    uint32_t sync_tx_done = 0;
     for (;;)
     {
-        // 等待发送信号量，确保队列中有完整的数据
-        if (osSemaphoreAcquire(uwb_txSemaphore, 0) == osOK)
+        // 阻塞等待INT引脚中断或发送队列事件；仍有积压时不阻塞
+        osThreadFlagsWait(UWB_EVT_ALL, osFlagsWaitAny, wait_ms);
+
+        // 按优先级获取发送消息
+        if (uwb_tx_next(&tx_msg, &is_sync))
         {
-            // 从队列获取发送消息
-            if (osMessageQueueGet(uwb_txQueue, tx_msg.get(), NULL, 0) == osOK)
+            switch (tx_msg.type)
             {
-                switch (tx_msg->type)
+            case UWB_MSG_TYPE_SEND_DATA:
+                // 发送UWB数据
+                {
+                    elog_i(TAG, "tx begin");
+                    uwb->update();
+                    if (is_sync)
+                    {
+                        sync_tx_pending = true;
+                        sync_tx_done = uwb->get_recv_stats().tx_done;
+                    }
+                    uwb->data_transmit(tx_msg.buf->data, tx_msg.buf->len);
+                    FramePool_Release(tx_msg.buf);
+                    // 发送完成后芯片自动回到接收，未开启时驱动在update()中补发接收命令
+                }
+                break;
+            case UWB_MSG_TYPE_SET_CHANNEL:
+                // 设置UWB信道
+                {
+                    uint8_t channel = tx_msg.param;
+                    elog_i(TAG, "Setting UWB channel to %d", channel);
+                    uwb->update();
+                    if (uwb->set_channel(channel))
+                    {
+                        elog_i(TAG, "UWB channel set to %d successfully", channel);
+                        uwb_publish_cx310_state(uwb.get());
+                    }
+                    else
+                    {
+                        elog_e(TAG, "Failed to set UWB channel to %d", channel);
+                    }
+                    // 重新启动接收模式
+                    uwb->set_recv_mode();
+                }
+                break;
+            case UWB_MSG_TYPE_SET_PROFILE:
+                // 切换PHY档位，整套参数一条命令下发，与当前值相同的参数不下发
                 {
-                case UWB_MSG_TYPE_SEND_DATA:
-                    // 发送UWB数据
+                    CX310PhyConfig phy = uwb_phy_profiles[tx_msg.param];
+                    uwb->update();
+                    uwb->get_channel(phy.channel);
+                    if (uwb->set_phy_config(phy))
                     {
-                        std::vector<uint8_t> tx_data(tx_msg->data, tx_msg->data + tx_msg->data_len);
-                        elog_i(TAG, "tx begin");
-                        uwb->update();
-                        uwb->data_transmit(tx_data);
-                        // 发送完成后重新启动接收
-                        // uwb.set_recv_mode();
+                        uwb_phy_profile = tx_msg.param;
+                        elog_i(TAG, "PHY profile %d applied", tx_msg.param);
                     }
-                    break;
-                case UWB_MSG_TYPE_SET_CHANNEL:
-                    // 设置UWB信道
-                    if (tx_msg->data_len >= 1)
+                    else
                     {
-                        uint8_t channel = tx_msg->data[0];
-                        elog_i(TAG, "Setting UWB channel to %d", channel);
-                        uwb->update();
-                        if (uwb->set_channel(channel))
-                        {
-                            elog_i(TAG, "UWB channel set to %d successfully", channel);
-                        }
-                        else
-                        {
-                            elog_e(TAG, "Failed to set UWB channel to %d", channel);
-                        }
-                        // 重新启动接收模式
-                        uwb->set_recv_mode();
+                        elog_e(TAG, "Failed to apply PHY profile %d", tx_msg.param);
                     }
-                    break;
-                case UWB_MSG_TYPE_CONFIG:
-                case UWB_MSG_TYPE_SET_MODE:
-                default:
-                    elog_w(TAG, "Unhandled message type: %d", tx_msg->type);
-                    break;
+                    uwb_publish_cx310_state(uwb.get());
+                    uwb->set_recv_mode();
                 }
+                break;
+            case UWB_MSG_TYPE_CONFIG:
+            case UWB_MSG_TYPE_SET_MODE:
+            default:
+                elog_w(TAG, "Unhandled message type: %d", tx_msg.type);
+                break;
             }
         }
 
-        if (uwb->get_recv_data(buffer))
+        bool has_rx = uwb->has_recv_data();
+
+        // CX310 发送完成通知不带时间信息，以驱动随该通知锁存的INT中断时刻作为同步帧发送时刻，
+        // 同步帧之后紧接的通知（如接收数据）产生的中断不会覆盖它
+        if (sync_tx_pending && uwb->get_recv_stats().tx_done != sync_tx_done)
+        {
+            sync_tx_pending = false;
+            uint64_t tx_time_us = uwb->get_tx_done_int_us(sync_tx_done + 1);
+            if (tx_time_us != 0)
+            {
+                uwb_publish_sync_tx_time(tx_time_us);
+            }
+        }
+
+        if (has_rx)
         {
-            // uwb->set_recv_mode();
-            // elog_w(TAG, "rx size: %d", buffer.size());
-            rx_msg->data_len = buffer.size();
-            for (int i = 0; i < rx_msg->data_len; i++)
+            // 缓冲池耗尽时数据保留在驱动中，下一轮再取
+            rx_msg.buf = FramePool_Alloc(0);
+            if (rx_msg.buf != NULL)
             {
-                rx_msg->data[i] = buffer[i];
+                // 接收通知同样不带时间信息，取驱动随该帧保存的INT中断时刻
+                uwb->get_recv_data(rx_msg.buf->data, FRAME_POOL_BLOCK_SIZE, rx_msg.buf->len, &rx_msg.rx_time_us);
+                // elog_w(TAG, "rx size: %d", rx_msg.buf->len);
+                rx_msg.data = rx_msg.buf->data;
+                rx_msg.data_len = rx_msg.buf->len;
+                rx_msg.timestamp = osKernelGetTickCount();
+                rx_msg.status_reg = 0;
+                // CX310 数据接收通知中不携带信号质量信息
+                rx_msg.rssi = UWB_RSSI_UNKNOWN;
+                rx_msg.quality = UWB_QUALITY_UNKNOWN;
+                uwb_rx_deliver(&rx_msg);
             }
-            rx_msg->timestamp = osKernelGetTickCount();
-            rx_msg->status_reg = 0;
-            osMessageQueuePut(uwb_rxQueue, rx_msg.get(), 0, 0);
             // osDelay(UWB_TX_DELAY_MS);
         }
 
-        uwb->update();
-        osDelay(1);
+        // 发送队列未清空时立即继续；接收数据因缓冲池耗尽滞留时隔一个tick重试；否则等待事件
+        if (UWB_GetTxQueueCount() > 0)
+        {
+            wait_ms = 0;
+        }
+        else if (uwb->has_recv_data())
+        {
+            wait_ms = 1;
+        }
+        else
+        {
+            wait_ms = UWB_IDLE_WAIT_MS;
+        }
     }
 }
 #endif
@@ -295,12 +886,24 @@ void UWB_Task_Init(void)
 {
     static const char *TAG = "uwb_init";
 
-    // 创建消息队列
-    uwb_txQueue = osMessageQueueNew(TX_QUEUE_SIZE, sizeof(uwb_tx_msg_t), NULL);
-    if (uwb_txQueue == NULL)
+    // 收发共用的帧缓冲池
+    FramePool_Init();
+
+    // 创建各发送类别的消息队列
+    static const uint16_t tx_depths[UWB_TX_CLASS_NUM] = {TX_SYNC_QUEUE_SIZE, TX_CONTROL_QUEUE_SIZE,
+                                                         TX_RETRY_QUEUE_SIZE, TX_PING_QUEUE_SIZE};
+    static const uwb_tx_drop_policy_t tx_policies[UWB_TX_CLASS_NUM] = {UWB_TX_DROP_OLDEST, UWB_TX_WAIT,
+                                                                       UWB_TX_DROP_NEWEST, UWB_TX_DROP_NEWEST};
+    for (int i = 0; i < UWB_TX_CLASS_NUM; i++)
     {
-        elog_e(TAG, "Failed to create UWB TX queue");
-        return;
+        uwb_txClasses[i].depth = tx_depths[i];
+        uwb_txClasses[i].policy = tx_policies[i];
+        uwb_txClasses[i].queue = osMessageQueueNew(tx_depths[i], sizeof(uwb_tx_msg_t), NULL);
+        if (uwb_txClasses[i].queue == NULL)
+        {
+            elog_e(TAG, "Failed to create UWB TX queue (class %d)", i);
+            return;
+        }
     }
 
     uwb_rxQueue = osMessageQueueNew(RX_QUEUE_SIZE, sizeof(uwb_rx_msg_t), NULL);
@@ -309,14 +912,6 @@ void UWB_Task_Init(void)
         elog_e(TAG, "Failed to create UWB RX queue");
         return;
     }
-
-    // 创建发送信号量（计数信号量，初始值为0）
-    uwb_txSemaphore = osSemaphoreNew(TX_QUEUE_SIZE, 0, NULL);
-    if (uwb_txSemaphore == NULL)
-    {
-        elog_e(TAG, "Failed to create UWB TX semaphore");
-        return;
-    }
     // 创建UWB通信任务
     const osThreadAttr_t uwbTask_attributes = {
         .name = "uwbCommTask",
@@ -335,6 +930,21 @@ void UWB_Task_Init(void)
     }
 }
 
+// 申请缓冲块并拷贝数据，控制类别在缓冲池耗尽时允许短暂等待
+static frame_buf_t *uwb_tx_alloc(const uint8_t *data, uint16_t len, uwb_tx_class_t tx_class)
+{
+    frame_buf_t *buf = FramePool_Alloc(tx_class == UWB_TX_CLASS_CONTROL ? TX_CONTROL_PUT_TIMEOUT_MS : 0);
+    if (buf == NULL)
+    {
+        uwb_txClasses[tx_class].dropped++;
+        return NULL;
+    }
+
+    memcpy(buf->data, data, len);
+    buf->len = len;
+    return buf;
+}
+
 // API函数：发送UWB数据
 int UWB_SendData(const uint8_t *data, uint16_t len, uint32_t delay_ms)
 {
@@ -345,28 +955,101 @@ int UWB_SendData(const uint8_t *data, uint16_t len, uint32_t delay_ms)
 
     uwb_tx_msg_t msg;
     msg.type = UWB_MSG_TYPE_SEND_DATA;
-    msg.data_len = len;
+    msg.param = 0;
     msg.delay_ms = delay_ms;
+    msg.buf = uwb_tx_alloc(data, len, UWB_TX_CLASS_CONTROL);
+    if (msg.buf == NULL)
+    {
+        return -2; // 缓冲池耗尽
+    }
+
+    return uwb_tx_enqueue(UWB_TX_CLASS_CONTROL, &msg);
+}
 
-    // 复制数据到消息结构体
-    for (uint16_t i = 0; i < len; i++)
+// API函数：按优先级类别发送UWB数据
+int UWB_SendDataPrio(const uint8_t *data, uint16_t len, uwb_tx_class_t tx_class)
+{
+    if (data == NULL || len == 0 || len > FRAME_LEN_MAX || tx_class >= UWB_TX_CLASS_NUM)
     {
-        msg.data[i] = data[i];
+        return -1;
     }
 
-    // 发送到队列
-    if (osMessageQueuePut(uwb_txQueue, &msg, 0, 100) != osOK)
+    uwb_tx_msg_t msg;
+    msg.type = UWB_MSG_TYPE_SEND_DATA;
+    msg.param = 0;
+    msg.delay_ms = 0;
+    msg.buf = uwb_tx_alloc(data, len, tx_class);
+    if (msg.buf == NULL)
     {
-        return -3; // 队列满或超时
+        return -2; // 缓冲池耗尽
     }
 
-    // 队列数据放入成功后，释放信号量通知通信任务
-    osSemaphoreRelease(uwb_txSemaphore);
+    return uwb_tx_enqueue(tx_class, &msg);
+}
 
-    return 0; // 成功
+// API函数：发送已填好的缓冲块（零拷贝）
+int UWB_SendBuffer(frame_buf_t *buf, uwb_tx_class_t tx_class)
+{
+    if (buf == NULL || buf->len == 0 || buf->len > FRAME_LEN_MAX || tx_class >= UWB_TX_CLASS_NUM)
+    {
+        FramePool_Release(buf);
+        return -1;
+    }
+
+    uwb_tx_msg_t msg;
+    msg.type = UWB_MSG_TYPE_SEND_DATA;
+    msg.param = 0;
+    msg.delay_ms = 0;
+    msg.buf = buf;
+
+    return uwb_tx_enqueue(tx_class, &msg);
 }
 
-// API函数：接收UWB数据（非阻塞）
+// API函数：获取发送类别统计
+int UWB_GetTxClassStats(uwb_tx_class_t tx_class, uwb_tx_class_stats_t *stats)
+{
+    if (stats == NULL || tx_class >= UWB_TX_CLASS_NUM)
+    {
+        return -1;
+    }
+
+    uwb_tx_class_ctx_t *ctx = &uwb_txClasses[tx_class];
+    stats->enqueued = ctx->enqueued;
+    stats->sent = ctx->sent;
+    stats->dropped = ctx->dropped;
+    stats->depth = ctx->depth;
+    stats->count = (uint16_t)osMessageQueueGetCount(ctx->queue);
+    stats->highWater = ctx->highWater;
+    return 0;
+}
+
+// API函数：获取发送聚合统计
+int UWB_GetTxAggStats(uwb_tx_agg_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return -1;
+    }
+
+    *stats = uwb_txAggStats;
+    return 0;
+}
+
+// API函数：获取最近一次同步帧的实际发送时刻
+int UWB_GetLastSyncTxTime(uwb_tx_time_t *tx_time)
+{
+    if (tx_time == NULL)
+    {
+        return -1;
+    }
+
+    osKernelLock();
+    *tx_time = uwb_syncTxTime;
+    osKernelUnlock();
+    return tx_time->seq != 0 ? 0 : -1;
+}
+
+// API函数：接收UWB数据
 int UWB_ReceiveData(uwb_rx_msg_t *msg, uint32_t timeout_ms)
 {
     if (msg == NULL)
@@ -382,6 +1065,20 @@ int UWB_ReceiveData(uwb_rx_msg_t *msg, uint32_t timeout_ms)
     return -1; // 超时或错误
 }
 
+// API函数：归还接收消息持有的缓冲块
+void UWB_ReleaseRxMsg(uwb_rx_msg_t *msg)
+{
+    if (msg == NULL)
+    {
+        return;
+    }
+
+    FramePool_Release(msg->buf);
+    msg->buf = NULL;
+    msg->data = NULL;
+    msg->data_len = 0;
+}
+
 // API函数：设置接收回调函数
 void UWB_SetRxCallback(uwb_rx_callback_t callback)
 {
@@ -391,7 +1088,12 @@ void UWB_SetRxCallback(uwb_rx_callback_t callback)
 // API函数：获取队列状态
 int UWB_GetTxQueueCount(void)
 {
-    return (int)osMessageQueueGetCount(uwb_txQueue);
+    int count = 0;
+    for (int i = 0; i < UWB_TX_CLASS_NUM; i++)
+    {
+        count += (int)osMessageQueueGetCount(uwb_txClasses[i].queue);
+    }
+    return (uwb_txCarryValid && !uwb_txCarryDrop) ? count + 1 : count;
 }
 
 int UWB_GetRxQueueCount(void)
@@ -403,10 +1105,15 @@ int UWB_GetRxQueueCount(void)
 void UWB_ClearTxQueue(void)
 {
     uwb_tx_msg_t msg;
-    while (osMessageQueueGet(uwb_txQueue, &msg, NULL, 0) == osOK)
+    for (int i = 0; i < UWB_TX_CLASS_NUM; i++)
     {
-        // 清空队列
+        while (osMessageQueueGet(uwb_txClasses[i].queue, &msg, NULL, 0) == osOK)
+        {
+            FramePool_Release(msg.buf);
+        }
     }
+    // 聚合遗留的消息只由UWB任务访问，通知其丢弃
+    uwb_txCarryDrop = true;
 }
 
 void UWB_ClearRxQueue(void)
@@ -414,7 +1121,7 @@ void UWB_ClearRxQueue(void)
     uwb_rx_msg_t msg;
     while (osMessageQueueGet(uwb_rxQueue, &msg, NULL, 0) == osOK)
     {
-        // 清空队列
+        UWB_ReleaseRxMsg(&msg);
     }
 }
 
@@ -423,19 +1130,57 @@ int UWB_Reconfigure(void)
 {
     uwb_tx_msg_t msg;
     msg.type = UWB_MSG_TYPE_CONFIG;
-    msg.data_len = 0;
+    msg.buf = NULL;
+    msg.param = 0;
+    msg.delay_ms = 0;
 
-    if (osMessageQueuePut(uwb_txQueue, &msg, 0, 100) != osOK)
+    // 配置消息走控制类别
+    if (uwb_tx_enqueue(UWB_TX_CLASS_CONTROL, &msg) != 0)
     {
         return -1; // 队列满或超时
     }
 
-    // 配置消息放入队列后，释放信号量通知通信任务
-    osSemaphoreRelease(uwb_txSemaphore);
+    return 0; // 成功
+}
+
+// API函数：切换PHY档位
+int UWB_SetPhyProfile(uwb_phy_profile_t profile)
+{
+    if (profile >= UWB_PHY_PROFILE_NUM)
+    {
+        return -1; // 参数错误
+    }
+
+    uwb_tx_msg_t msg;
+    msg.type = UWB_MSG_TYPE_SET_PROFILE;
+    msg.buf = NULL;
+    msg.param = (uint8_t)profile;
+    msg.delay_ms = 0;
+
+    // 配置消息走控制类别
+    if (uwb_tx_enqueue(UWB_TX_CLASS_CONTROL, &msg) != 0)
+    {
+        return -1; // 队列满或超时
+    }
 
     return 0; // 成功
 }
 
+// API函数：获取当前射频配置快照
+int UWB_GetRadioState(uwb_radio_state_t *state)
+{
+    if (state == NULL)
+    {
+        return -1;
+    }
+
+    osKernelLock();
+    *state = uwb_radio_state;
+    osKernelUnlock();
+
+    return state->valid ? 0 : -1;
+}
+
 // API函数：设置UWB信道
 int UWB_SetChannel(uint8_t channel)
 {
@@ -447,17 +1192,15 @@ int UWB_SetChannel(uint8_t channel)
 
     uwb_tx_msg_t msg;
     msg.type = UWB_MSG_TYPE_SET_CHANNEL;
-    msg.data_len = 1;
-    msg.data[0] = channel;
+    msg.buf = NULL;
+    msg.param = channel;
     msg.delay_ms = 0;
 
-    if (osMessageQueuePut(uwb_txQueue, &msg, 0, 100) != osOK)
+    // 配置消息走控制类别
+    if (uwb_tx_enqueue(UWB_TX_CLASS_CONTROL, &msg) != 0)
     {
         return -1; // 队列满或超时
     }
 
-    // 配置消息放入队列后，释放信号量通知通信任务
-    osSemaphoreRelease(uwb_txSemaphore);
-
     return 0; // 成功
 }
\ No newline at end of file
@@ -3,38 +3,137 @@
 
 #include <stdint.h>
 
+#include "frame_pool.h"
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
 #define FRAME_LEN_MAX 1016
+#define UWB_RSSI_UNKNOWN (-128)
+#define UWB_QUALITY_UNKNOWN 0xFF
+#define UWB_WAIT_FOREVER 0xFFFFFFFFU // UWB_ReceiveData一直等待直到收到数据
 
     // UWB接收消息结构体
+    // data指向缓冲池中的buf，使用完毕后必须调用UWB_ReleaseRxMsg归还
     typedef struct
     {
         uint16_t data_len;
-        uint8_t data[FRAME_LEN_MAX];
-        uint32_t timestamp;  // 接收时间戳
+        uint8_t *data;       // 接收数据（指向buf->data）
+        frame_buf_t *buf;    // 持有的缓冲块
+        uint32_t timestamp;  // 接收时间戳（系统tick）
+        uint64_t rx_time_us; // 接收时刻（hptimer微秒时基），0表示不可用
+                             // DW1000由芯片RX时间戳换算，CX310取接收通知的INT中断时刻
         uint32_t status_reg; // 状态寄存器值
+        int8_t rssi;         // 接收信号强度 (dBm)，UWB_RSSI_UNKNOWN表示芯片不支持
+        uint8_t quality;     // 首径信噪比 (dB)，UWB_QUALITY_UNKNOWN表示芯片不支持
     } uwb_rx_msg_t;
 
-    // 接收数据回调函数指针
+    // 发送优先级类别，数值越小优先级越高
+    typedef enum
+    {
+        UWB_TX_CLASS_SYNC = 0, // TDMA同步广播，队列满时丢弃最旧的同步帧
+        UWB_TX_CLASS_CONTROL,  // 控制命令/配置，队列满时等待超时后拒绝
+        UWB_TX_CLASS_RETRY,    // 命令重发，队列满时直接拒绝新帧
+        UWB_TX_CLASS_PING,     // Ping等尽力而为流量，队列满时直接拒绝新帧
+        UWB_TX_CLASS_NUM
+    } uwb_tx_class_t;
+
+    // 每个发送类别的统计
+    typedef struct
+    {
+        uint32_t enqueued;  // 成功入队次数
+        uint32_t sent;      // 出队交给芯片发送的次数
+        uint32_t dropped;   // 因队列满被丢弃的帧数（含被挤出的旧帧）
+        uint16_t depth;     // 队列深度
+        uint16_t count;     // 当前排队数量
+        uint16_t highWater; // 最大排队数量
+    } uwb_tx_class_stats_t;
+
+    // 发送聚合统计（同步帧按单帧计入）
+    typedef struct
+    {
+        uint32_t transmissions; // 空口发送次数
+        uint32_t frames;        // 发送的应用帧总数
+        uint32_t aggregated;    // 包含多帧的发送次数
+        uint16_t maxFrames;     // 单次发送的最多帧数
+    } uwb_tx_agg_stats_t;
+
+    // 同步帧实际发送时刻
+    typedef struct
+    {
+        uint32_t seq;        // 每记录一次同步帧发送加1
+        uint64_t tx_time_us; // 发送时刻（hptimer微秒时基）
+    } uwb_tx_time_t;
+
+    // UWB PHY档位，数值越小速率越高、覆盖距离越短
+    typedef enum
+    {
+        UWB_PHY_PROFILE_HIGH_THROUGHPUT = 0, // 短前导码、高速率，适合小范围部署
+        UWB_PHY_PROFILE_BALANCED,            // 均衡（上电默认）
+        UWB_PHY_PROFILE_LONG_RANGE,          // 长前导码、低速率，适合大厂房
+        UWB_PHY_PROFILE_NUM
+    } uwb_phy_profile_t;
+
+#define UWB_PHY_PROFILE_DEFAULT UWB_PHY_PROFILE_BALANCED
+
+    // UWB射频配置快照，由UWB任务在配置生效后发布，读取时不访问芯片
+    typedef struct
+    {
+        uint8_t valid;           // 0 - 尚未完成配置
+        uint8_t channel;         // 信道号
+        uint8_t prf_mode;        // 脉冲重复频率（芯片相关编码）
+        uint8_t preamble_length; // 前导码长度（芯片相关编码）
+        uint8_t preamble_index;  // 前导码索引
+        uint8_t data_rate;       // 数据速率（芯片相关编码）
+        uint8_t profile;         // 当前PHY档位（uwb_phy_profile_t）
+        uint32_t updated_tick;   // 最后一次更新的系统tick
+    } uwb_radio_state_t;
+
+    // 接收数据回调函数指针，msg只在回调期间有效，需要保留数据时调用FramePool_Retain(msg->buf)
     typedef void (*uwb_rx_callback_t)(const uwb_rx_msg_t *msg);
 
     // 初始化UWB通信任务
     void UWB_Task_Init(void);
 
-    // API函数：发送UWB数据
+    // API函数：发送UWB数据（控制类别）
     // 参数：data - 要发送的数据, len - 数据长度, delay_ms - 发送延迟时间（毫秒）
-    // 返回：0 - 成功, -1 - 参数错误, -3 - 队列满或超时
+    // 返回：0 - 成功, -1 - 参数错误, -2 - 缓冲池耗尽, -3 - 队列满或超时
     int UWB_SendData(const uint8_t *data, uint16_t len, uint32_t delay_ms);
 
-    // API函数：接收UWB数据（非阻塞）
-    // 参数：msg - 接收消息缓冲区, timeout_ms - 超时时间（毫秒）
+    // API函数：按优先级类别发送UWB数据
+    // 参数：data - 要发送的数据, len - 数据长度, tx_class - 发送类别
+    // 返回：0 - 成功（SYNC类别可能挤出了旧帧）, -1 - 参数错误, -2 - 缓冲池耗尽, -3 - 队列满被丢弃
+    int UWB_SendDataPrio(const uint8_t *data, uint16_t len, uwb_tx_class_t tx_class);
+
+    // API函数：发送已填好的缓冲块（零拷贝）
+    // 参数：buf - 由FramePool_Alloc申请并填好len/data的缓冲块, tx_class - 发送类别
+    // 无论成功与否buf的所有权都转移给UWB任务，调用者不能再访问或释放
+    // 返回：0 - 成功, -1 - 参数错误, -3 - 队列满被丢弃
+    int UWB_SendBuffer(frame_buf_t *buf, uwb_tx_class_t tx_class);
+
+    // API函数：获取发送类别统计
+    // 返回：0 - 成功, -1 - 参数错误
+    int UWB_GetTxClassStats(uwb_tx_class_t tx_class, uwb_tx_class_stats_t *stats);
+
+    // API函数：获取发送聚合统计
+    // 返回：0 - 成功, -1 - 参数错误
+    int UWB_GetTxAggStats(uwb_tx_agg_stats_t *stats);
+
+    // API函数：获取最近一次同步帧的实际发送时刻
+    // DW1000由芯片TX时间戳换算，CX310取发送完成通知的INT中断时刻
+    // 返回：0 - 成功, -1 - 参数错误或尚未发送过同步帧
+    int UWB_GetLastSyncTxTime(uwb_tx_time_t *tx_time);
+
+    // API函数：接收UWB数据
+    // 参数：msg - 接收消息缓冲区, timeout_ms - 超时时间（毫秒），0为非阻塞，UWB_WAIT_FOREVER为一直等待
     // 返回：0 - 成功, -1 - 超时或错误
     int UWB_ReceiveData(uwb_rx_msg_t *msg, uint32_t timeout_ms);
 
+    // API函数：归还接收消息持有的缓冲块（msg为NULL或已归还时忽略）
+    void UWB_ReleaseRxMsg(uwb_rx_msg_t *msg);
+
     // API函数：设置接收回调函数
     // 参数：callback - 回调函数指针，当接收到数据时自动调用
     void UWB_SetRxCallback(uwb_rx_callback_t callback);
@@ -51,11 +150,20 @@ extern "C"
     // 返回：0 - 成功, -1 - 队列满或超时
     int UWB_Reconfigure(void);
 
+    // API函数：获取当前射频配置快照（不阻塞，不等待UWB任务）
+    // 返回：0 - 成功, -1 - 参数错误或尚未完成配置
+    int UWB_GetRadioState(uwb_radio_state_t *state);
+
     // API函数：设置UWB信道
     // 参数：channel - 信道号 (5-10)
     // 返回：0 - 成功, -1 - 参数错误, -2 - 设置失败
     int UWB_SetChannel(uint8_t channel);
 
+    // API函数：切换PHY档位（保持当前信道）
+    // 参数：profile - 目标档位
+    // 返回：0 - 成功, -1 - 参数错误或队列满
+    int UWB_SetPhyProfile(uwb_phy_profile_t profile);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,7 +45,10 @@ enum class Backend2MasterMessageId : uint8_t {
     PING_CTRL_MSG = 0x10,
     DEVICE_LIST_REQ_MSG = 0x11,
     CLEAR_DEVICE_LIST_MSG = 0x12,
-    SET_UWB_CHAN_MSG = 0x13
+    SET_UWB_CHAN_MSG = 0x13,
+    LINK_STATS_REQ_MSG = 0x14,
+    PHY_PROFILE_CFG_MSG = 0x15,
+    UWB_BENCH_CTRL_MSG = 0x16
 };
 
 // Master2Backend Message ID 枚举
@@ -57,7 +60,10 @@ enum class Master2BackendMessageId : uint8_t {
     PING_RES_MSG = 0x04,
     DEVICE_LIST_RSP_MSG = 0x05,
     INTERVAL_CFG_RSP_MSG = 0x06,
-    SET_UWB_CHAN_RSP_MSG = 0x13
+    SET_UWB_CHAN_RSP_MSG = 0x13,
+    LINK_STATS_RSP_MSG = 0x14,
+    PHY_PROFILE_CFG_RSP_MSG = 0x15,
+    UWB_BENCH_RES_MSG = 0x16
 };
 
 // Slave2Backend Message ID 枚举
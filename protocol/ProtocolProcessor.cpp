@@ -231,6 +231,15 @@ std::unique_ptr<Message> ProtocolProcessor::createMessage(PacketId packetId,
                 case Backend2MasterMessageId::SET_UWB_CHAN_MSG:
                     return std::make_unique<
                         Backend2Master::SetUwbChannelMessage>();
+                case Backend2MasterMessageId::LINK_STATS_REQ_MSG:
+                    return std::make_unique<
+                        Backend2Master::LinkStatsReqMessage>();
+                case Backend2MasterMessageId::PHY_PROFILE_CFG_MSG:
+                    return std::make_unique<
+                        Backend2Master::PhyProfileConfigMessage>();
+                case Backend2MasterMessageId::UWB_BENCH_CTRL_MSG:
+                    return std::make_unique<
+                        Backend2Master::UwbBenchCtrlMessage>();
             }
             break;
 
@@ -260,6 +269,15 @@ std::unique_ptr<Message> ProtocolProcessor::createMessage(PacketId packetId,
                 case Master2BackendMessageId::SET_UWB_CHAN_RSP_MSG:
                     return std::make_unique<
                         Master2Backend::SetUwbChannelResponseMessage>();
+                case Master2BackendMessageId::LINK_STATS_RSP_MSG:
+                    return std::make_unique<
+                        Master2Backend::LinkStatsResponseMessage>();
+                case Master2BackendMessageId::PHY_PROFILE_CFG_RSP_MSG:
+                    return std::make_unique<
+                        Master2Backend::PhyProfileConfigResponseMessage>();
+                case Master2BackendMessageId::UWB_BENCH_RES_MSG:
+                    return std::make_unique<
+                        Master2Backend::UwbBenchResultMessage>();
             }
             break;
 
@@ -502,22 +520,27 @@ std::vector<std::vector<uint8_t>> ProtocolProcessor::fragmentFrame(
 
 // Process received raw data (supports packet concatenation handling)
 void ProtocolProcessor::processReceivedData(const std::vector<uint8_t> &data) {
+    processReceivedData(data.data(), data.size());
+}
+
+// 直接从调用者的缓冲区（如网络协议栈的pbuf）追加数据，避免中间拷贝
+void ProtocolProcessor::processReceivedData(const uint8_t *data, size_t len) {
     // elog_v("ProtocolProcessor",
-    //        "Received new data, size: %d bytes, prefix: %s", data.size(),
+    //        "Received new data, size: %d bytes, prefix: %s", len,
     //        bytesToHexString(data, 8).c_str());
 
     // Prevent receive buffer from becoming too large
-    if (receiveBuffer_.size() + data.size() > MAX_RECEIVE_BUFFER_SIZE) {
+    if (receiveBuffer_.size() + len > MAX_RECEIVE_BUFFER_SIZE) {
         elog_w("ProtocolProcessor",
                "Receive buffer will exceed maximum limit, clearing buffer. "
                "Current size: %d, new data size: %d, max limit: %d",
-               receiveBuffer_.size(), data.size(), MAX_RECEIVE_BUFFER_SIZE);
+               receiveBuffer_.size(), len, MAX_RECEIVE_BUFFER_SIZE);
         // Clear buffer to prevent memory overflow
         receiveBuffer_.clear();
     }
 
     // Add new data to receive buffer
-    receiveBuffer_.insert(receiveBuffer_.end(), data.begin(), data.end());
+    receiveBuffer_.insert(receiveBuffer_.end(), data, data + len);
     elog_v("ProtocolProcessor", "Current receive buffer size: %d bytes",
            receiveBuffer_.size());
 
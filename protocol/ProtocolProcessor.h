@@ -82,6 +82,7 @@ class ProtocolProcessor {
 
     // 处理接收到的原始数据 (支持粘包处理)
     void processReceivedData(const std::vector<uint8_t> &data);
+    void processReceivedData(const uint8_t *data, size_t len);
 
     // 获取完整的已解析帧
     bool getNextCompleteFrame(Frame &frame);
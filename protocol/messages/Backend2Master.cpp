@@ -190,5 +190,54 @@ bool SetUwbChannelMessage::deserialize(const std::vector<uint8_t> &data) {
     return true;
 }
 
+// LinkStatsReqMessage 实现
+std::vector<uint8_t> LinkStatsReqMessage::serialize() const {
+    std::vector<uint8_t> result;
+    ByteUtils::writeUint32LE(result, targetId);
+    result.push_back(clear);
+    return result;
+}
+
+bool LinkStatsReqMessage::deserialize(const std::vector<uint8_t> &data) {
+    if (data.size() < 5)
+        return false;
+    targetId = ByteUtils::readUint32LE(data, 0);
+    clear = data[4];
+    return true;
+}
+
+// PhyProfileConfigMessage 实现
+std::vector<uint8_t> PhyProfileConfigMessage::serialize() const {
+    return {profile, adaptive};
+}
+
+bool PhyProfileConfigMessage::deserialize(const std::vector<uint8_t> &data) {
+    if (data.size() < 2)
+        return false;
+    profile = data[0];
+    adaptive = data[1];
+    return true;
+}
+
+// UwbBenchCtrlMessage 实现
+std::vector<uint8_t> UwbBenchCtrlMessage::serialize() const {
+    std::vector<uint8_t> result;
+    ByteUtils::writeUint32LE(result, targetId);
+    ByteUtils::writeUint16LE(result, packetSize);
+    ByteUtils::writeUint16LE(result, count);
+    ByteUtils::writeUint16LE(result, interval);
+    return result;
+}
+
+bool UwbBenchCtrlMessage::deserialize(const std::vector<uint8_t> &data) {
+    if (data.size() < 10)
+        return false;
+    targetId = ByteUtils::readUint32LE(data, 0);
+    packetSize = ByteUtils::readUint16LE(data, 4);
+    count = ByteUtils::readUint16LE(data, 6);
+    interval = ByteUtils::readUint16LE(data, 8);
+    return true;
+}
+
 } // namespace Backend2Master
 } // namespace WhtsProtocol
\ No newline at end of file
@@ -156,6 +156,56 @@ class SetUwbChannelMessage : public Message {
     }
 };
 
+class LinkStatsReqMessage : public Message {
+   public:
+    uint32_t targetId;  // 目标从机 ID，0xFFFFFFFF 表示所有从机
+    uint8_t clear;      // 1: 读取后清零统计
+
+    std::vector<uint8_t> serialize() const override;
+    bool deserialize(const std::vector<uint8_t> &data) override;
+    uint8_t getMessageId() const override {
+        return static_cast<uint8_t>(
+            Backend2MasterMessageId::LINK_STATS_REQ_MSG);
+    }
+    const char* getMessageTypeName() const override {
+        return "Link Stats Request";
+    }
+};
+
+class PhyProfileConfigMessage : public Message {
+   public:
+    uint8_t profile;   // 0: 高吞吐, 1: 均衡, 2: 远距离
+    uint8_t adaptive;  // 1: 按从机丢包率自动切换档位
+
+    std::vector<uint8_t> serialize() const override;
+    bool deserialize(const std::vector<uint8_t> &data) override;
+    uint8_t getMessageId() const override {
+        return static_cast<uint8_t>(
+            Backend2MasterMessageId::PHY_PROFILE_CFG_MSG);
+    }
+    const char* getMessageTypeName() const override {
+        return "PHY Profile Config";
+    }
+};
+
+class UwbBenchCtrlMessage : public Message {
+   public:
+    uint32_t targetId;    // 目标从机 ID（不支持广播）
+    uint16_t packetSize;  // 每帧空口长度（字节）
+    uint16_t count;       // 发送帧数，0 表示停止正在进行的测试
+    uint16_t interval;    // 发送间隔（ms），0 表示按发送队列空位连续发送
+
+    std::vector<uint8_t> serialize() const override;
+    bool deserialize(const std::vector<uint8_t> &data) override;
+    uint8_t getMessageId() const override {
+        return static_cast<uint8_t>(
+            Backend2MasterMessageId::UWB_BENCH_CTRL_MSG);
+    }
+    const char* getMessageTypeName() const override {
+        return "UWB Bench Control";
+    }
+};
+
 }    // namespace Backend2Master
 }    // namespace WhtsProtocol
 
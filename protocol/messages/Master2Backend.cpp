@@ -131,6 +131,18 @@ std::vector<uint8_t> PingResponseMessage::serialize() const {
     // Write destination ID (4 bytes, little endian)
     ByteUtils::writeUint32LE(result, destinationId);
 
+    // Per-slave RTT statistics (26 bytes each)
+    result.push_back(slaveNum);
+    for (const auto &slave : slaves) {
+        ByteUtils::writeUint32LE(result, slave.slaveId);
+        ByteUtils::writeUint16LE(result, slave.successCount);
+        ByteUtils::writeUint32LE(result, slave.minRttUs);
+        ByteUtils::writeUint32LE(result, slave.meanRttUs);
+        ByteUtils::writeUint32LE(result, slave.maxRttUs);
+        ByteUtils::writeUint32LE(result, slave.p50RttUs);
+        ByteUtils::writeUint32LE(result, slave.p99RttUs);
+    }
+
     return result;
 }
 
@@ -143,6 +155,30 @@ bool PingResponseMessage::deserialize(const std::vector<uint8_t> &data) {
     successCount = ByteUtils::readUint16LE(data, 3);
     destinationId = ByteUtils::readUint32LE(data, 5);
 
+    // RTT statistics are optional (older firmware sends 9 bytes only)
+    slaveNum = 0;
+    slaves.clear();
+    if (data.size() < 10)
+        return true;
+
+    slaveNum = data[9];
+    size_t offset = 10;
+    for (uint8_t i = 0; i < slaveNum; ++i) {
+        if (offset + 26 > data.size())
+            return false;
+
+        SlaveRttInfo slave;
+        slave.slaveId = ByteUtils::readUint32LE(data, offset);
+        slave.successCount = ByteUtils::readUint16LE(data, offset + 4);
+        slave.minRttUs = ByteUtils::readUint32LE(data, offset + 6);
+        slave.meanRttUs = ByteUtils::readUint32LE(data, offset + 10);
+        slave.maxRttUs = ByteUtils::readUint32LE(data, offset + 14);
+        slave.p50RttUs = ByteUtils::readUint32LE(data, offset + 18);
+        slave.p99RttUs = ByteUtils::readUint32LE(data, offset + 22);
+        slaves.push_back(slave);
+        offset += 26;
+    }
+
     return true;
 }
 
@@ -221,5 +257,118 @@ bool SetUwbChannelResponseMessage::deserialize(const std::vector<uint8_t> &data)
     return true;
 }
 
+// LinkStatsResponseMessage 实现
+std::vector<uint8_t> LinkStatsResponseMessage::serialize() const {
+    std::vector<uint8_t> result;
+    ByteUtils::writeUint32LE(result, masterTimeMs);
+    result.push_back(slaveNum);
+
+    for (const auto &slave : slaves) {
+        ByteUtils::writeUint32LE(result, slave.slaveId);
+        ByteUtils::writeUint32LE(result, slave.rxFrames);
+        ByteUtils::writeUint16LE(result, slave.seqGaps);
+        ByteUtils::writeUint16LE(result, slave.retries);
+        ByteUtils::writeUint16LE(result, slave.retryRecovered);
+        ByteUtils::writeUint16LE(result, slave.retryExhausted);
+        ByteUtils::writeUint32LE(result, slave.lastRxTimeMs);
+        result.push_back(static_cast<uint8_t>(slave.rssi));
+        result.push_back(slave.quality);
+    }
+
+    return result;
+}
+
+bool LinkStatsResponseMessage::deserialize(const std::vector<uint8_t> &data) {
+    if (data.size() < 5)
+        return false;
+
+    masterTimeMs = ByteUtils::readUint32LE(data, 0);
+    slaveNum = data[4];
+    slaves.clear();
+
+    size_t offset = 5;
+    for (uint8_t i = 0; i < slaveNum; ++i) {
+        if (offset + 22 > data.size())
+            return false; // Each entry is 22 bytes
+
+        SlaveLinkInfo slave;
+        slave.slaveId = ByteUtils::readUint32LE(data, offset);
+        slave.rxFrames = ByteUtils::readUint32LE(data, offset + 4);
+        slave.seqGaps = ByteUtils::readUint16LE(data, offset + 8);
+        slave.retries = ByteUtils::readUint16LE(data, offset + 10);
+        slave.retryRecovered = ByteUtils::readUint16LE(data, offset + 12);
+        slave.retryExhausted = ByteUtils::readUint16LE(data, offset + 14);
+        slave.lastRxTimeMs = ByteUtils::readUint32LE(data, offset + 16);
+        slave.rssi = static_cast<int8_t>(data[offset + 20]);
+        slave.quality = data[offset + 21];
+        slaves.push_back(slave);
+        offset += 22;
+    }
+
+    return true;
+}
+
+// PhyProfileConfigResponseMessage 实现
+std::vector<uint8_t> PhyProfileConfigResponseMessage::serialize() const {
+    return {status, profile, adaptive};
+}
+
+bool PhyProfileConfigResponseMessage::deserialize(const std::vector<uint8_t> &data) {
+    if (data.size() < 3)
+        return false;
+
+    status = data[0];
+    profile = data[1];
+    adaptive = data[2];
+    return true;
+}
+
+// UwbBenchResultMessage 实现
+std::vector<uint8_t> UwbBenchResultMessage::serialize() const {
+    std::vector<uint8_t> result;
+    result.push_back(status);
+    ByteUtils::writeUint32LE(result, targetId);
+    ByteUtils::writeUint16LE(result, packetSize);
+    ByteUtils::writeUint16LE(result, totalCount);
+    ByteUtils::writeUint16LE(result, sentCount);
+    ByteUtils::writeUint16LE(result, receivedCount);
+    ByteUtils::writeUint16LE(result, lostCount);
+    ByteUtils::writeUint16LE(result, reorderedCount);
+    ByteUtils::writeUint16LE(result, duplicateCount);
+    ByteUtils::writeUint32LE(result, durationMs);
+    ByteUtils::writeUint32LE(result, txThroughputBps);
+    ByteUtils::writeUint32LE(result, minRttUs);
+    ByteUtils::writeUint32LE(result, p50RttUs);
+    ByteUtils::writeUint32LE(result, p90RttUs);
+    ByteUtils::writeUint32LE(result, p99RttUs);
+    ByteUtils::writeUint32LE(result, maxRttUs);
+    ByteUtils::writeUint32LE(result, rxThroughputBps);
+    return result;
+}
+
+bool UwbBenchResultMessage::deserialize(const std::vector<uint8_t> &data) {
+    if (data.size() < 51)
+        return false;
+
+    status = data[0];
+    targetId = ByteUtils::readUint32LE(data, 1);
+    packetSize = ByteUtils::readUint16LE(data, 5);
+    totalCount = ByteUtils::readUint16LE(data, 7);
+    sentCount = ByteUtils::readUint16LE(data, 9);
+    receivedCount = ByteUtils::readUint16LE(data, 11);
+    lostCount = ByteUtils::readUint16LE(data, 13);
+    reorderedCount = ByteUtils::readUint16LE(data, 15);
+    duplicateCount = ByteUtils::readUint16LE(data, 17);
+    durationMs = ByteUtils::readUint32LE(data, 19);
+    txThroughputBps = ByteUtils::readUint32LE(data, 23);
+    minRttUs = ByteUtils::readUint32LE(data, 27);
+    p50RttUs = ByteUtils::readUint32LE(data, 31);
+    p90RttUs = ByteUtils::readUint32LE(data, 35);
+    p99RttUs = ByteUtils::readUint32LE(data, 39);
+    maxRttUs = ByteUtils::readUint32LE(data, 43);
+    rxThroughputBps = ByteUtils::readUint32LE(data, 47);
+    return true;
+}
+
 } // namespace Master2Backend
 } // namespace WhtsProtocol
\ No newline at end of file
@@ -91,6 +91,20 @@ class PingResponseMessage : public Message {
     uint16_t successCount;
     uint32_t destinationId;
 
+    // 每个从机的RTT统计 (us)，旧版本后端可忽略该扩展部分
+    struct SlaveRttInfo {
+        uint32_t slaveId;
+        uint16_t successCount;
+        uint32_t minRttUs;
+        uint32_t meanRttUs;
+        uint32_t maxRttUs;
+        uint32_t p50RttUs;
+        uint32_t p99RttUs;
+    };
+
+    uint8_t slaveNum = 0;
+    std::vector<SlaveRttInfo> slaves;
+
     std::vector<uint8_t> serialize() const override;
     bool deserialize(const std::vector<uint8_t> &data) override;
     uint8_t getMessageId() const override {
@@ -158,6 +172,83 @@ class SetUwbChannelResponseMessage : public Message {
     }
 };
 
+class LinkStatsResponseMessage : public Message {
+  public:
+    struct SlaveLinkInfo {
+        uint32_t slaveId;
+        uint32_t rxFrames;
+        uint16_t seqGaps;
+        uint16_t retries;
+        uint16_t retryRecovered;
+        uint16_t retryExhausted;
+        uint32_t lastRxTimeMs;  // 主机时间 (ms)，0 表示从未收到
+        int8_t rssi;            // dBm，-128 表示未知
+        uint8_t quality;        // 首径信噪比 (dB)，0xFF 表示未知
+    };
+
+    uint32_t masterTimeMs;  // 响应生成时的主机时间 (ms)
+    uint8_t slaveNum;
+    std::vector<SlaveLinkInfo> slaves;
+
+    std::vector<uint8_t> serialize() const override;
+    bool deserialize(const std::vector<uint8_t> &data) override;
+    uint8_t getMessageId() const override {
+        return static_cast<uint8_t>(
+            Master2BackendMessageId::LINK_STATS_RSP_MSG);
+    }
+    const char* getMessageTypeName() const override {
+        return "Link Stats Response";
+    }
+};
+
+class PhyProfileConfigResponseMessage : public Message {
+  public:
+    uint8_t status;    // 0: Success, 1: Failure
+    uint8_t profile;   // 当前生效（或正在切换到）的档位
+    uint8_t adaptive;  // 自适应切换是否开启
+
+    std::vector<uint8_t> serialize() const override;
+    bool deserialize(const std::vector<uint8_t> &data) override;
+    uint8_t getMessageId() const override {
+        return static_cast<uint8_t>(
+            Master2BackendMessageId::PHY_PROFILE_CFG_RSP_MSG);
+    }
+    const char* getMessageTypeName() const override {
+        return "PHY Profile Config Response";
+    }
+};
+
+class UwbBenchResultMessage : public Message {
+  public:
+    uint8_t status;          // 0: 完成, 1: 请求无效或已有测试在运行, 2: 被停止或中途停滞
+    uint32_t targetId;
+    uint16_t packetSize;     // 实际使用的每帧空口长度
+    uint16_t totalCount;     // 请求的帧数
+    uint16_t sentCount;      // 实际交给UWB发送的帧数
+    uint16_t receivedCount;  // 收到响应的帧数（去重）
+    uint16_t lostCount;      // sentCount - receivedCount
+    uint16_t reorderedCount; // 序号小于已收到最大序号的响应数
+    uint16_t duplicateCount; // 重复响应数
+    uint32_t durationMs;     // 首帧发送到最后一次收到响应
+    uint32_t txThroughputBps; // 主机->从机：receivedCount * packetSize * 8 / duration
+    uint32_t minRttUs;
+    uint32_t p50RttUs;
+    uint32_t p90RttUs;
+    uint32_t p99RttUs;
+    uint32_t maxRttUs;
+    uint32_t rxThroughputBps; // 从机->主机：receivedCount * 响应帧长 * 8 / duration
+
+    std::vector<uint8_t> serialize() const override;
+    bool deserialize(const std::vector<uint8_t> &data) override;
+    uint8_t getMessageId() const override {
+        return static_cast<uint8_t>(
+            Master2BackendMessageId::UWB_BENCH_RES_MSG);
+    }
+    const char* getMessageTypeName() const override {
+        return "UWB Bench Result";
+    }
+};
+
 } // namespace Master2Backend
 } // namespace WhtsProtocol
 
@@ -121,6 +121,9 @@ std::vector<uint8_t> PingReqMessage::serialize() const {
     result.push_back((timestamp >> 8) & 0xFF);
     result.push_back((timestamp >> 16) & 0xFF);
     result.push_back((timestamp >> 24) & 0xFF);
+    for (uint16_t i = 0; i < paddingLength; i++) {
+        result.push_back(i & 0xFF);
+    }
     return result;
 }
 
@@ -128,6 +131,7 @@ bool PingReqMessage::deserialize(const std::vector<uint8_t> &data) {
     if (data.size() < 6) return false;
     sequenceNumber = data[0] | (data[1] << 8);
     timestamp = data[2] | (data[3] << 8) | (data[4] << 16) | (data[5] << 24);
+    paddingLength = static_cast<uint16_t>(data.size() - 6);
     return true;
 }
 
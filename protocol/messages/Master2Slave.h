@@ -49,6 +49,7 @@ class PingReqMessage : public Message {
    public:
     uint16_t sequenceNumber;
     uint32_t timestamp;
+    uint16_t paddingLength = 0;  // 尾部填充字节数（吞吐测试用），从机忽略
 
     std::vector<uint8_t> serialize() const override;
     bool deserialize(const std::vector<uint8_t>& data) override;